@@ -0,0 +1,135 @@
+// Compares Config reads through the published snapshot with the per-config
+// std::shared_mutex that Config used before, with several threads reading the
+// same configuration.
+
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <cstddef>
+
+#include <benchmark/benchmark.h>
+
+#include "benchmarkutils.hpp"
+#include "fsutils/internal/Config.hpp"
+
+namespace {
+    constexpr int KeyCount_ = 256;
+
+    /**
+     * @brief The read path of Config before snapshots: every lookup takes a
+     * shared lock on the configuration's mutex.
+     */
+    class LockedConfig_ {
+        std::unique_ptr<ConfigStore> store_;
+        mutable std::shared_mutex mutex_;
+
+    public:
+        explicit LockedConfig_(const std::filesystem::path& path)
+            : store_(openConfigStore(path))
+        {}
+
+        template <typename T>
+        T get(const std::string_view key, const T& defaultValue) const
+        {
+            std::shared_lock lock(mutex_);
+
+            return withPathSegments(key, [&](const PathSegments segments) {
+                const auto value = store_->getInt(key, segments);
+
+                return value.has_value() ? static_cast<T>(*value)
+                                         : defaultValue;
+            });
+        }
+    };
+
+    template <typename ConfigType>
+    struct SharedConfig_ {
+        std::unique_ptr<ConfigType> config;
+        std::string error;
+    };
+
+    /**
+     * @brief Returns the configuration of the given format shared by the
+     * threads of a benchmark, opening it on the first call.
+     */
+    template <typename ConfigType>
+    const SharedConfig_<ConfigType>&
+        getSharedConfig_(const ConfigFormat format)
+    {
+        static const auto openConfig = [](const ConfigFormat format) {
+            SharedConfig_<ConfigType> shared;
+
+            try {
+                // Each kind of config gets its own file, since a mapped file
+                // can't be rewritten.
+                const auto path = writeBenchmarkConfigFile(
+                    std::is_same_v<ConfigType, Config> ? "ConfigRead"
+                                                       : "LockedConfigRead",
+                    format,
+                    makeBenchmarkConfigKeys(KeyCount_));
+
+                if constexpr (std::is_same_v<ConfigType, Config>) {
+                    shared.config =
+                        std::make_unique<Config>(path, "YASTMBenchmarks");
+                } else {
+                    shared.config = std::make_unique<ConfigType>(path);
+                }
+            } catch (const std::exception& error) {
+                shared.error = error.what();
+            }
+
+            return shared;
+        };
+        static const SharedConfig_<ConfigType> configs[] = {
+            openConfig(ConfigFormat::Toml),
+            openConfig(ConfigFormat::Binary),
+        };
+
+        return configs[static_cast<int>(format)];
+    }
+
+    /**
+     * @brief Every thread reads the keys of the same configuration in turn,
+     * like several scripts reading their MCM settings. The argument is the
+     * ConfigFormat of the file.
+     */
+    template <typename ConfigType>
+    void BM_ConfigRead(benchmark::State& state)
+    {
+        const auto& [config, error] = getSharedConfig_<ConfigType>(
+            static_cast<ConfigFormat>(state.range(0)));
+
+        if (config == nullptr) {
+            state.SkipWithError(error.c_str());
+            return;
+        }
+
+        const auto keys = makeBenchmarkConfigKeys(KeyCount_);
+        auto index = static_cast<std::size_t>(state.thread_index());
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(
+                config->get(std::string_view(keys[index++ % keys.size()]), 0));
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_ConfigRead, LockedConfig_)
+    ->ArgName("format")
+    ->Arg(static_cast<int>(ConfigFormat::Toml))
+    ->Arg(static_cast<int>(ConfigFormat::Binary))
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ConfigRead, Config)
+    ->ArgName("format")
+    ->Arg(static_cast<int>(ConfigFormat::Toml))
+    ->Arg(static_cast<int>(ConfigFormat::Binary))
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
@@ -0,0 +1,189 @@
+// Compares the TOML and binary backends of YASTMFSUtils configurations: opening
+// a file, reading and setting values, and serializing the data for saving.
+//
+// The arguments are the ConfigFormat and the number of values in the file.
+
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+#include "benchmarkutils.hpp"
+#include "fsutils/internal/ParsedConfigCache.hpp"
+
+namespace {
+    /**
+     * @brief The number of values set by a script saving its settings.
+     */
+    constexpr int SetKeyCount_ = 16;
+
+    struct BenchmarkStore_ {
+        std::filesystem::path path;
+        std::vector<std::string> keys;
+        std::unique_ptr<ConfigStore> store;
+    };
+
+    /**
+     * @brief Writes the file for the benchmark arguments and opens it.
+     *
+     * @returns std::nullopt if the file could not be opened. The benchmark is
+     * marked as failed.
+     */
+    std::optional<BenchmarkStore_>
+        openBenchmarkStore_(benchmark::State& state, const std::string& stem)
+    {
+        const auto format = static_cast<ConfigFormat>(state.range(0));
+        const auto keyCount = static_cast<int>(state.range(1));
+
+        try {
+            BenchmarkStore_ benchmarkStore;
+
+            benchmarkStore.keys = makeBenchmarkConfigKeys(keyCount);
+            benchmarkStore.path = writeBenchmarkConfigFile(
+                stem + std::to_string(keyCount),
+                format,
+                benchmarkStore.keys);
+            benchmarkStore.store = openConfigStore(benchmarkStore.path);
+
+            return benchmarkStore;
+        } catch (const std::exception& error) {
+            state.SkipWithError(error.what());
+        }
+
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Inserts SetKeyCount_ values that aren't in the file yet.
+     */
+    void setValues_(ConfigStore& store)
+    {
+        for (int i = 0; i < SetKeyCount_; ++i) {
+            const auto key = "saved.key" + std::to_string(i);
+
+            withPathSegments(key, [&](const PathSegments segments) {
+                store.insert(key, segments, ConfigValue(std::int64_t{i}));
+            });
+        }
+    }
+
+    /**
+     * @brief Opens the file as a script opening its settings does. TOML files
+     * are removed from ParsedConfigCache first, so that every open parses the
+     * file.
+     */
+    void BM_ConfigStoreOpen(benchmark::State& state)
+    {
+        const auto benchmarkStore = openBenchmarkStore_(state, "Open");
+
+        if (!benchmarkStore.has_value()) {
+            return;
+        }
+
+        const auto& path = benchmarkStore->path;
+
+        for (auto _ : state) {
+            ParsedConfigCache::getInstance().erase(path);
+            benchmark::DoNotOptimize(openConfigStore(path));
+        }
+
+        state.SetBytesProcessed(
+            state.iterations() *
+            static_cast<std::int64_t>(std::filesystem::file_size(path)));
+    }
+
+    void BM_ConfigStoreGet(benchmark::State& state)
+    {
+        const auto benchmarkStore = openBenchmarkStore_(state, "Get");
+
+        if (!benchmarkStore.has_value()) {
+            return;
+        }
+
+        const auto& [path, keys, store] = *benchmarkStore;
+        std::size_t index = 0;
+
+        for (auto _ : state) {
+            const std::string_view key = keys[index++ % keys.size()];
+
+            benchmark::DoNotOptimize(
+                withPathSegments(key, [&](const PathSegments segments) {
+                    return store->getInt(key, segments);
+                }));
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    /**
+     * @brief Sets SetKeyCount_ new values in a copy of the opened store, like
+     * Config does for the first change after opening a file.
+     */
+    void BM_ConfigStoreSet(benchmark::State& state)
+    {
+        const auto benchmarkStore = openBenchmarkStore_(state, "Set");
+
+        if (!benchmarkStore.has_value()) {
+            return;
+        }
+
+        for (auto _ : state) {
+            const auto store = benchmarkStore->store->clone();
+
+            setValues_(*store);
+            benchmark::DoNotOptimize(store);
+        }
+
+        state.SetItemsProcessed(state.iterations() * SetKeyCount_);
+    }
+
+    /**
+     * @brief Serializes the opened store with SetKeyCount_ new values, which
+     * is what ConfigWriter writes to the file. ConfigWriter only appends the
+     * part of a binary file after the existing contents, which isn't measured
+     * here.
+     */
+    void BM_ConfigStoreSave(benchmark::State& state)
+    {
+        const auto benchmarkStore = openBenchmarkStore_(state, "Save");
+
+        if (!benchmarkStore.has_value()) {
+            return;
+        }
+
+        const auto store = benchmarkStore->store->clone();
+        std::int64_t byteCount = 0;
+
+        setValues_(*store);
+
+        for (auto _ : state) {
+            const auto contents = store->serialize();
+
+            byteCount += static_cast<std::int64_t>(contents.size());
+            benchmark::DoNotOptimize(contents.data());
+        }
+
+        state.SetBytesProcessed(byteCount);
+    }
+
+    void applyArguments_(benchmark::internal::Benchmark* const benchmark)
+    {
+        benchmark->ArgNames({"format", "values"})
+            ->ArgsProduct(
+                {{static_cast<int>(ConfigFormat::Toml),
+                  static_cast<int>(ConfigFormat::Binary)},
+                 {64, 1024}});
+    }
+} // namespace
+
+BENCHMARK(BM_ConfigStoreOpen)->Apply(applyArguments_);
+BENCHMARK(BM_ConfigStoreGet)->Apply(applyArguments_);
+BENCHMARK(BM_ConfigStoreSet)->Apply(applyArguments_);
+BENCHMARK(BM_ConfigStoreSave)->Apply(applyArguments_);
@@ -0,0 +1,148 @@
+// Compares the handle lookup of every YASTMFSUtils Papyrus call through
+// HandleTable with the std::map behind a std::shared_mutex that ConfigManager
+// used before.
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+
+#include <cstddef>
+
+#include <benchmark/benchmark.h>
+
+#include "fsutils/internal/HandleTable.hpp"
+
+namespace {
+    constexpr int OpenConfigCount_ = 64;
+
+    /**
+     * @brief Stands in for a Config. Each lookup reads a value from it, like
+     * GetInt() does.
+     */
+    struct Payload_ {
+        int value = 1;
+    };
+
+    /**
+     * @brief The handle lookup of ConfigManager before HandleTable. Handles
+     * are reused as the largest handle + 1, and lookups return a plain
+     * reference that isn't kept alive.
+     */
+    class LockedHandleMap_ {
+        std::map<int, std::shared_ptr<Payload_>> map_;
+        mutable std::shared_mutex mutex_;
+
+    public:
+        int insert(std::shared_ptr<Payload_> value)
+        {
+            std::unique_lock lock(mutex_);
+
+            const int handle = map_.empty() ? 1 : map_.rbegin()->first + 1;
+            map_.emplace(handle, std::move(value));
+
+            return handle;
+        }
+
+        void erase(const int handle)
+        {
+            std::unique_lock lock(mutex_);
+
+            map_.erase(handle);
+        }
+
+        Payload_* get(const int handle) const
+        {
+            std::shared_lock lock(mutex_);
+
+            const auto it = map_.find(handle);
+
+            return it != map_.end() ? it->second.get() : nullptr;
+        }
+    };
+
+    using HandleTable_ = HandleTable<Payload_>;
+
+    /**
+     * @brief Returns the table shared by the threads of a benchmark, holding
+     * OpenConfigCount_ open configurations.
+     */
+    template <typename Table>
+    std::pair<Table&, const std::vector<int>&> getSharedTable_()
+    {
+        static Table table;
+        static const std::vector<int> handles = [] {
+            std::vector<int> handles;
+
+            for (int i = 0; i < OpenConfigCount_; ++i) {
+                handles.push_back(table.insert(std::make_shared<Payload_>()));
+            }
+
+            return handles;
+        }();
+
+        return {table, handles};
+    }
+
+    template <typename Table>
+    void lookUp_(const Table& table, const int handle)
+    {
+        const auto config = table.get(handle);
+
+        benchmark::DoNotOptimize(config->value);
+    }
+
+    /**
+     * @brief Every thread looks up the open configurations in turn.
+     */
+    template <typename Table>
+    void BM_HandleLookup(benchmark::State& state)
+    {
+        const auto [table, handles] = getSharedTable_<Table>();
+        auto index = static_cast<std::size_t>(state.thread_index());
+
+        for (auto _ : state) {
+            lookUp_(table, handles[index++ % handles.size()]);
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    /**
+     * @brief Like BM_HandleLookup, but the first thread also opens and closes
+     * a configuration every 64 lookups, like a script that saves its settings
+     * to a temporary file.
+     */
+    template <typename Table>
+    void BM_HandleLookupWithChurn(benchmark::State& state)
+    {
+        const auto [table, handles] = getSharedTable_<Table>();
+        const bool isOpeningConfigs = state.thread_index() == 0;
+        auto index = static_cast<std::size_t>(state.thread_index());
+
+        for (auto _ : state) {
+            if (isOpeningConfigs && index % 64 == 0) {
+                table.erase(table.insert(std::make_shared<Payload_>()));
+            }
+
+            lookUp_(table, handles[index++ % handles.size()]);
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_HandleLookup, LockedHandleMap_)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_HandleLookup, HandleTable_)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_HandleLookupWithChurn, LockedHandleMap_)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_HandleLookupWithChurn, HandleTable_)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
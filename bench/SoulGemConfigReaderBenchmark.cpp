@@ -0,0 +1,136 @@
+// Compares reading the soul gem groups of a YASTM_*.toml file with
+// SoulGemConfigReader against parsing it into a toml++ document first, as
+// loadIndividualConfigFiles_() did before.
+//
+// The argument is the number of soul gem groups in the file. Each benchmark
+// also reports the peak memory allocated while reading the file once.
+
+#include <exception>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+#include <fmt/format.h>
+
+#include <benchmark/benchmark.h>
+#include <toml++/toml.h>
+
+#include "benchmarkutils.hpp"
+#include "config/SoulGemConfigReader.hpp"
+#include "config/SoulGemGroup.hpp"
+
+namespace {
+    /**
+     * @brief Returns the contents of a configuration file with the given number
+     * of grand soul gem groups, in the style of the example configurations.
+     */
+    std::string makeSoulGemConfig_(const int groupCount)
+    {
+        std::string contents = "# Generated for YASTMBenchmarks.\n";
+
+        for (int group = 0; group < groupCount; ++group) {
+            contents += fmt::format(
+                "\n[[soulGems]]\n"
+                "id = \"Grand Soul Gem {}\"\n"
+                "isReusable = false\n"
+                "capacity = 5\n"
+                "members = [\n",
+                group);
+
+            // Empty, petty, lesser, common, greater, and grand.
+            for (int member = 0; member < 6; ++member) {
+                contents += fmt::format(
+                    "    [0x{:x}, \"YASTM.esp\"], # Member {}\n",
+                    0x800 + group * 6 + member,
+                    member);
+            }
+
+            contents += "]\n";
+        }
+
+        return contents;
+    }
+
+    std::filesystem::path writeSoulGemConfig_(const int groupCount)
+    {
+        const auto path = getBenchmarkFilePath(
+            "YASTM_Benchmark" + std::to_string(groupCount) + ".toml");
+
+        writeBenchmarkFile(path, makeSoulGemConfig_(groupCount));
+
+        return path;
+    }
+
+    std::vector<SoulGemGroup> readWithDocument_(const std::filesystem::path& path)
+    {
+        std::vector<SoulGemGroup> groups;
+
+        const auto table = toml::parse_file(path.string());
+
+        if (const auto soulGems = table["soulGems"].as_array();
+            soulGems != nullptr) {
+            for (const auto& element : *soulGems) {
+                if (const auto soulGem = element.as_table();
+                    soulGem != nullptr) {
+                    groups.emplace_back(*soulGem);
+                }
+            }
+        }
+
+        return groups;
+    }
+
+    std::vector<SoulGemGroup> readWithReader_(const std::filesystem::path& path)
+    {
+        std::vector<SoulGemGroup> groups;
+
+        const auto source = SoulGemConfigReader::readFile(path);
+
+        SoulGemConfigReader(source).read(
+            [&](SoulGemGroup::Fields&& fields, SourcePosition) {
+                groups.emplace_back(fields);
+            },
+            [](SourcePosition) {});
+
+        return groups;
+    }
+
+    template <std::vector<SoulGemGroup> (*read)(const std::filesystem::path&)>
+    void BM_ReadSoulGemConfig(benchmark::State& state)
+    {
+        const auto groupCount = static_cast<int>(state.range(0));
+        const auto path = writeSoulGemConfig_(groupCount);
+
+        try {
+            if (read(path).size() != static_cast<std::size_t>(groupCount)) {
+                state.SkipWithError("Not every soul gem group was read.");
+                return;
+            }
+        } catch (const std::exception& error) {
+            state.SkipWithError(error.what());
+            return;
+        }
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(read(path));
+        }
+
+        state.SetBytesProcessed(
+            state.iterations() *
+            static_cast<std::int64_t>(std::filesystem::file_size(path)));
+        state.counters["peakBytes"] = static_cast<double>(
+            measurePeakAllocatedBytes([&] { read(path); }));
+    }
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_ReadSoulGemConfig, readWithDocument_)
+    ->ArgName("groups")
+    ->RangeMultiplier(8)
+    ->Range(8, 4096);
+BENCHMARK_TEMPLATE(BM_ReadSoulGemConfig, readWithReader_)
+    ->ArgName("groups")
+    ->RangeMultiplier(8)
+    ->Range(8, 4096);
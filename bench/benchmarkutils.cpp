@@ -0,0 +1,166 @@
+#include "benchmarkutils.hpp"
+
+#include <atomic>
+#include <fstream>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+#include <cstdint>
+#include <cstdlib>
+
+namespace {
+    // Every allocation is prefixed with its size so that operator delete can
+    // subtract it. The prefix keeps the default alignment of operator new.
+    constexpr std::size_t SizePrefix_ = alignof(std::max_align_t);
+
+    std::atomic<std::size_t> allocatedBytes_ = 0;
+    std::atomic<std::size_t> peakBytes_ = 0;
+    std::atomic<std::size_t> baseBytes_ = 0;
+
+    void* allocate_(const std::size_t size) noexcept
+    {
+        const auto block =
+            static_cast<unsigned char*>(std::malloc(size + SizePrefix_));
+
+        if (block == nullptr) {
+            return nullptr;
+        }
+
+        *reinterpret_cast<std::size_t*>(block) = size;
+
+        const auto allocatedBytes =
+            allocatedBytes_.fetch_add(size, std::memory_order_relaxed) + size;
+        auto peakBytes = peakBytes_.load(std::memory_order_relaxed);
+
+        while (allocatedBytes > peakBytes &&
+               !peakBytes_.compare_exchange_weak(
+                   peakBytes,
+                   allocatedBytes,
+                   std::memory_order_relaxed)) {
+        }
+
+        return block + SizePrefix_;
+    }
+
+    void deallocate_(void* const pointer) noexcept
+    {
+        if (pointer == nullptr) {
+            return;
+        }
+
+        const auto block = static_cast<unsigned char*>(pointer) - SizePrefix_;
+
+        allocatedBytes_.fetch_sub(
+            *reinterpret_cast<std::size_t*>(block),
+            std::memory_order_relaxed);
+        std::free(block);
+    }
+} // namespace
+
+void* operator new(const std::size_t size)
+{
+    if (const auto pointer = allocate_(size); pointer != nullptr) {
+        return pointer;
+    }
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](const std::size_t size) { return operator new(size); }
+
+void* operator new(const std::size_t size, const std::nothrow_t&) noexcept
+{
+    return allocate_(size);
+}
+
+void* operator new[](const std::size_t size, const std::nothrow_t&) noexcept
+{
+    return allocate_(size);
+}
+
+void operator delete(void* const pointer) noexcept { deallocate_(pointer); }
+void operator delete[](void* const pointer) noexcept { deallocate_(pointer); }
+
+void operator delete(void* const pointer, std::size_t) noexcept
+{
+    deallocate_(pointer);
+}
+
+void operator delete[](void* const pointer, std::size_t) noexcept
+{
+    deallocate_(pointer);
+}
+
+std::filesystem::path getBenchmarkFilePath(const std::string_view fileName)
+{
+    const auto directory =
+        std::filesystem::temp_directory_path() / "YASTMBenchmarks";
+
+    std::filesystem::create_directories(directory);
+
+    return directory / fileName;
+}
+
+void writeBenchmarkFile(
+    const std::filesystem::path& path,
+    const std::string_view contents)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+    file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+
+    if (!file) {
+        throw std::runtime_error(
+            "Could not write benchmark file \"" + path.string() + "\"");
+    }
+}
+
+std::vector<std::string> makeBenchmarkConfigKeys(const int keyCount)
+{
+    std::vector<std::string> keys;
+    keys.reserve(static_cast<std::size_t>(keyCount));
+
+    for (int i = 0; i < keyCount; ++i) {
+        keys.push_back(
+            "section" + std::to_string(i % 8) + ".key" + std::to_string(i));
+    }
+
+    return keys;
+}
+
+std::filesystem::path writeBenchmarkConfigFile(
+    const std::string_view fileStem,
+    const ConfigFormat format,
+    const std::vector<std::string>& keys)
+{
+    const auto store = createConfigStore(format);
+    std::int64_t value = 0;
+
+    for (const auto& key : keys) {
+        withPathSegments(key, [&](const PathSegments segments) {
+            store->insert(key, segments, ConfigValue(value++));
+        });
+    }
+
+    auto path = getBenchmarkFilePath(fileStem);
+    path += getFileExtension(format);
+
+    writeBenchmarkFile(path, store->serialize());
+
+    return path;
+}
+
+void resetPeakAllocatedBytes() noexcept
+{
+    const auto allocatedBytes = allocatedBytes_.load(std::memory_order_relaxed);
+
+    baseBytes_.store(allocatedBytes, std::memory_order_relaxed);
+    peakBytes_.store(allocatedBytes, std::memory_order_relaxed);
+}
+
+std::size_t getPeakAllocatedBytes() noexcept
+{
+    return peakBytes_.load(std::memory_order_relaxed) -
+           baseBytes_.load(std::memory_order_relaxed);
+}
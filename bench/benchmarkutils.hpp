@@ -0,0 +1,66 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <cstddef>
+
+#include "fsutils/internal/ConfigStore.hpp"
+
+/**
+ * @brief Returns the path of a scratch file for the benchmarks, in a
+ * "YASTMBenchmarks" folder of the system's temporary directory.
+ */
+std::filesystem::path getBenchmarkFilePath(std::string_view fileName);
+
+/**
+ * @brief Replaces the contents of the file.
+ *
+ * @throws std::runtime_error The file could not be written.
+ */
+void writeBenchmarkFile(
+    const std::filesystem::path& path,
+    std::string_view contents);
+
+/**
+ * @brief Returns keyCount distinct dotted keys, spread over a few sections
+ * like the settings of an MCM.
+ */
+std::vector<std::string> makeBenchmarkConfigKeys(int keyCount);
+
+/**
+ * @brief Writes a configuration file of the given format with an int value for
+ * every key.
+ *
+ * @returns The path of the file.
+ */
+std::filesystem::path writeBenchmarkConfigFile(
+    std::string_view fileStem,
+    ConfigFormat format,
+    const std::vector<std::string>& keys);
+
+/**
+ * @brief Starts measuring the peak memory allocated through the global
+ * operator new from the current usage.
+ */
+void resetPeakAllocatedBytes() noexcept;
+
+/**
+ * @brief Returns the peak memory allocated through the global operator new
+ * since the last call to resetPeakAllocatedBytes(), in bytes.
+ */
+std::size_t getPeakAllocatedBytes() noexcept;
+
+/**
+ * @brief Calls fn() once and returns the peak memory it allocated, in bytes.
+ * Only meaningful for single-threaded code.
+ */
+template <typename Fn>
+std::size_t measurePeakAllocatedBytes(Fn&& fn)
+{
+    resetPeakAllocatedBytes();
+    fn();
+    return getPeakAllocatedBytes();
+}
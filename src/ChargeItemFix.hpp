@@ -1,3 +1,3 @@
-#pragma once
-
-bool installChargeItemFix();
+#pragma once
+
+bool installChargeItemFix();
@@ -1,3 +1,3 @@
-#pragma once
-
-bool installEnchantItemFix();
+#pragma once
+
+bool installEnchantItemFix();
@@ -1,8 +1,8 @@
-#pragma once
-
-#include <RE/Skyrim.h>
-#include <SKSE/SKSE.h>
-
-#include <spdlog/sinks/basic_file_sink.h>
-
-using namespace std::literals;
+#pragma once
+
+#include <RE/Skyrim.h>
+#include <SKSE/SKSE.h>
+
+#include <spdlog/sinks/basic_file_sink.h>
+
+using namespace std::literals;
@@ -1,7 +1,7 @@
-#pragma once
-
-namespace SKSE {
-    class LoadInterface;
-} // end namespace SKSE
-
-bool installTrapSoulFix(const SKSE::LoadInterface* loadInterface);
+#pragma once
+
+namespace SKSE {
+    class LoadInterface;
+} // end namespace SKSE
+
+bool installTrapSoulFix(const SKSE::LoadInterface* loadInterface);
@@ -1,84 +1,98 @@
-#pragma once
-
-#include <optional>
-#include <string>
-
-#include <toml++/toml.h>
-
-#include <RE/T/TESDataHandler.h>
-
-#include "FormLocator.hpp"
-#include "FormError.hpp"
-
-namespace RE {
-    class TESDataHandler;
-} // end namespace RE
-
-template <typename T>
-class Form {
-protected:
-    std::optional<FormLocator> formLocator_;
-    T* form_ = nullptr;
-
-public:
-    static constexpr auto FormType = T::FORMTYPE;
-
-    explicit Form() noexcept {}
-    virtual ~Form() {}
-
-    void setFromTomlArray(const toml::array& arr);
-    void setFromTomlString(std::string str);
-    void loadForm(RE::TESDataHandler* dataHandler);
-    void clear() noexcept
-    {
-        formLocator_.reset();
-        form_ = nullptr;
-    }
-
-    const FormLocator& formLocator() const { return formLocator_.value(); }
-    T* form() const noexcept { return form_; }
-
-    bool isConfigLoaded() const noexcept { return formLocator_.has_value(); }
-    bool isFormLoaded() const noexcept { return form_ != nullptr; }
-};
-
-template <typename T>
-inline void Form<T>::setFromTomlArray(const toml::array& arr)
-{
-    formLocator_.emplace(FormId(arr));
-}
-
-template <typename T>
-inline void Form<T>::setFromTomlString(std::string str)
-{
-    formLocator_.emplace(str);
-}
-
-template <typename T>
-inline void Form<T>::loadForm(RE::TESDataHandler* const dataHandler)
-{
-    using namespace std::literals;
-
-    if (!formLocator_.has_value()) {
-        return;
-    }
-
-    const auto& formLocator = formLocator_.value();
-
-    auto form = getFormForLocator(formLocator, dataHandler);
-
-    if (form == nullptr) {
-        std::visit(
-            [](auto&& formLocator) { throw MissingFormError(formLocator); },
-            formLocator);
-    }
-
-    form_ = form->As<T>();
-
-    if (form_ == nullptr) {
-        throw UnexpectedFormTypeError(
-            FormType,
-            form->GetFormType(),
-            form->GetName());
-    }
-}
+#pragma once
+
+#include <optional>
+#include <string>
+#include <utility>
+
+#include <toml++/toml.h>
+
+#include <RE/T/TESForm.h>
+
+#include "FormLocator.hpp"
+#include "FormError.hpp"
+#include "FormResolver.hpp"
+
+template <typename T>
+class Form {
+protected:
+    std::optional<FormLocator> formLocator_;
+    T* form_ = nullptr;
+    bool isConfigLoaded_ = false;
+
+public:
+    static constexpr auto FormType = T::FORMTYPE;
+
+    explicit Form() noexcept {}
+    virtual ~Form() {}
+
+    void setFromTomlArray(const toml::array& arr);
+    void setFromTomlString(std::string str);
+    void loadForm(const FormResolver& resolver);
+    void clear() noexcept
+    {
+        formLocator_.reset();
+        form_ = nullptr;
+        isConfigLoaded_ = false;
+    }
+    /**
+     * @brief Releases the form locator once it is no longer needed. The loaded
+     * form (if any) is kept, and isConfigLoaded() is unaffected.
+     */
+    void releaseFormLocator() noexcept { formLocator_.reset(); }
+
+    /**
+     * @brief Returns the form locator read from the configuration file.
+     *
+     * @throws std::bad_optional_access No locator was configured, or it was
+     * already released.
+     */
+    const FormLocator& formLocator() const { return formLocator_.value(); }
+    T* form() const noexcept { return form_; }
+
+    bool isConfigLoaded() const noexcept { return isConfigLoaded_; }
+    bool hasFormLocator() const noexcept { return formLocator_.has_value(); }
+    bool isFormLoaded() const noexcept { return form_ != nullptr; }
+};
+
+template <typename T>
+inline void Form<T>::setFromTomlArray(const toml::array& arr)
+{
+    formLocator_.emplace(FormId(arr));
+    isConfigLoaded_ = true;
+}
+
+template <typename T>
+inline void Form<T>::setFromTomlString(std::string str)
+{
+    formLocator_.emplace(std::move(str));
+    isConfigLoaded_ = true;
+}
+
+template <typename T>
+inline void Form<T>::loadForm(const FormResolver& resolver)
+{
+    using namespace std::literals;
+
+    if (!formLocator_.has_value()) {
+        return;
+    }
+
+    const auto& formLocator = formLocator_.value();
+
+    auto form = resolver.get(formLocator);
+
+    if (form == nullptr) {
+        std::visit(
+            [](auto&& formLocator) { throw MissingFormError(formLocator); },
+            formLocator);
+    }
+
+    form_ = form->As<T>();
+
+    if (form_ == nullptr) {
+        throw UnexpectedFormTypeError(
+            FormType,
+            form->GetFormType(),
+            form->GetName());
+    }
+}
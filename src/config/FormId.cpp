@@ -1,25 +1,45 @@
-#include "FormId.hpp"
-
-#include "ParseError.hpp"
-
-FormId::FormId(const toml::array& arr)
-{
-    auto formIdValue = arr[0].as_integer();
-    auto pluginNameValue = arr[1].as_string();
-
-    if (formIdValue == nullptr) {
-        throw ParseError("Form ID is missing or invalid");
-    }
-
-    if (pluginNameValue == nullptr) {
-        throw ParseError("Plugin name is missing or invalid");
-    }
-
-    id_ = static_cast<RE::FormID>(formIdValue->get());
-    pluginName_ = pluginNameValue->get();
-}
-
-FormId::FormId(const RE::FormID id, std::string_view pluginName)
-    : id_(id)
-    , pluginName_(pluginName)
-{}
+#include "FormId.hpp"
+
+#include "ParseError.hpp"
+
+namespace {
+    template <typename T>
+    std::optional<T>
+        getArrayValue_(const toml::array& arr, const std::size_t index)
+    {
+        const auto node = arr.get(index);
+
+        if (node == nullptr) {
+            return std::nullopt;
+        }
+
+        return node->value_exact<T>();
+    }
+} // namespace
+
+FormId::FormId(const toml::array& arr)
+    : FormId(
+          getArrayValue_<std::int64_t>(arr, 0),
+          getArrayValue_<std::string>(arr, 1))
+{}
+
+FormId::FormId(const RE::FormID id, std::string_view pluginName)
+    : key_(makeKey_(id, PluginNameTable::getInstance().intern(pluginName)))
+{}
+
+FormId::FormId(
+    const std::optional<std::int64_t>& id,
+    const std::optional<std::string>& pluginName)
+{
+    if (!id.has_value()) {
+        throw ParseError("Form ID is missing or invalid");
+    }
+
+    if (!pluginName.has_value()) {
+        throw ParseError("Plugin name is missing or invalid");
+    }
+
+    key_ = makeKey_(
+        static_cast<RE::FormID>(*id),
+        PluginNameTable::getInstance().intern(*pluginName));
+}
@@ -0,0 +1,114 @@
+#include "FormResolver.hpp"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <RE/B/BSFixedString.h>
+#include <RE/T/TESDataHandler.h>
+#include <RE/T/TESForm.h>
+
+#include "../global.hpp"
+#include "../utilities/formidutils.hpp"
+
+void FormResolver::add(const FormLocator& formLocator)
+{
+    forms_.try_emplace(formLocator, nullptr);
+}
+
+void FormResolver::resolve(RE::TESDataHandler* const dataHandler)
+{
+    resolveFormIds_(dataHandler);
+    resolveEditorIds_();
+}
+
+void FormResolver::resolveFormIds_(RE::TESDataHandler* const dataHandler)
+{
+    using namespace std::literals;
+
+    // Group the form IDs by plugin so we only need to look up each plugin once.
+    std::unordered_map<
+        PluginNameTable::IndexType,
+        std::vector<decltype(forms_)::value_type*>>
+        pluginToEntriesMap;
+
+    for (auto& entry : forms_) {
+        if (const auto formId = std::get_if<FormId>(&entry.first);
+            formId != nullptr) {
+            pluginToEntriesMap[formId->pluginIndex()].push_back(&entry);
+        }
+    }
+
+    std::vector<std::pair<RE::FormID, RE::TESForm**>> resolvedFormIds;
+    resolvedFormIds.reserve(forms_.size());
+
+    for (const auto& [pluginIndex, entries] : pluginToEntriesMap) {
+        const auto& pluginName =
+            std::get<FormId>(entries.front()->first).pluginName();
+        const auto file = dataHandler->LookupModByName(pluginName);
+
+        if (file == nullptr || file->compileIndex == 0xFF) {
+            LOG_WARN_FMT("Plugin \"{}\" is not loaded."sv, pluginName);
+            continue;
+        }
+
+        for (const auto entry : entries) {
+            resolvedFormIds.emplace_back(
+                toResolvedFormId(std::get<FormId>(entry->first).id(), file),
+                &entry->second);
+        }
+    }
+
+    const auto [allForms, lock] = RE::TESForm::GetAllForms();
+
+    if (allForms == nullptr) {
+        return;
+    }
+
+    RE::BSReadLockGuard locker(lock);
+
+    for (const auto [formId, form] : resolvedFormIds) {
+        if (const auto it = allForms->find(formId); it != allForms->end()) {
+            *form = it->second;
+        }
+    }
+}
+
+void FormResolver::resolveEditorIds_()
+{
+    std::vector<std::pair<RE::BSFixedString, RE::TESForm**>> editorIds;
+
+    for (auto& [formLocator, form] : forms_) {
+        if (const auto editorId = std::get_if<std::string>(&formLocator);
+            editorId != nullptr) {
+            editorIds.emplace_back(*editorId, &form);
+        }
+    }
+
+    if (editorIds.empty()) {
+        return;
+    }
+
+    const auto [allForms, lock] = RE::TESForm::GetAllFormsByEditorID();
+
+    if (allForms == nullptr) {
+        return;
+    }
+
+    RE::BSReadLockGuard locker(lock);
+
+    for (const auto& [editorId, form] : editorIds) {
+        if (const auto it = allForms->find(editorId); it != allForms->end()) {
+            *form = it->second;
+        }
+    }
+}
+
+RE::TESForm* FormResolver::get(const FormLocator& formLocator) const
+{
+    if (const auto it = forms_.find(formLocator); it != forms_.end()) {
+        return it->second;
+    }
+
+    return nullptr;
+}
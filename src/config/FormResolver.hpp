@@ -0,0 +1,38 @@
+#pragma once
+
+#include <unordered_map>
+
+#include "FormLocator.hpp"
+
+namespace RE {
+    class TESDataHandler;
+    class TESForm;
+} // end namespace RE
+
+/**
+ * @brief Resolves a set of form locators to their in-game forms in one batch.
+ *
+ * @details Locators are collected with add() before calling resolve(). Form ID
+ * locators are grouped by plugin so that each plugin's compile index is looked
+ * up once, and all lookups of the same kind are done under a single lock of
+ * the game's form maps. Each distinct locator is only resolved once, no matter
+ * how many times it was added.
+ */
+class FormResolver {
+    std::unordered_map<FormLocator, RE::TESForm*> forms_;
+
+    void resolveFormIds_(RE::TESDataHandler* dataHandler);
+    void resolveEditorIds_();
+
+public:
+    void add(const FormLocator& formLocator);
+    void resolve(RE::TESDataHandler* dataHandler);
+
+    /**
+     * @brief Returns the form resolved for the given locator, or nullptr if the
+     * form does not exist or the locator was never added.
+     */
+    RE::TESForm* get(const FormLocator& formLocator) const;
+
+    std::size_t size() const noexcept { return forms_.size(); }
+};
@@ -0,0 +1,91 @@
+#include "LoadReport.hpp"
+
+#include <fstream>
+#include <utility>
+
+#include <cstdint>
+
+#include <toml++/toml.h>
+
+#include "../global.hpp"
+
+using namespace std::literals;
+
+void LoadReport::addPhase(std::string name, const double seconds)
+{
+    phases_.push_back({std::move(name), seconds});
+}
+
+void LoadReport::clear()
+{
+    phases_.clear();
+    fileCount_ = 0;
+    soulGemGroupCount_ = 0;
+    formCount_ = 0;
+    errorCount_ = 0;
+    memoryBeforeCompaction_ = 0;
+    memoryAfterCompaction_ = 0;
+}
+
+void LoadReport::print() const
+{
+    LOG_INFO("Configuration load report:");
+
+    for (const auto& phase : phases_) {
+        LOG_INFO_FMT("- {}: {:.7f} seconds"sv, phase.name, phase.seconds);
+    }
+
+    LOG_INFO_FMT(
+        "- Files: {}, soul gem groups: {}, forms: {}, errors: {}"sv,
+        fileCount_,
+        soulGemGroupCount_,
+        formCount_,
+        errorCount_);
+
+    if (memoryBeforeCompaction_ > 0) {
+        LOG_INFO_FMT(
+            "- Estimated configuration memory: {} bytes before compaction, {} bytes after"sv,
+            memoryBeforeCompaction_,
+            memoryAfterCompaction_);
+    }
+}
+
+bool LoadReport::writeJson(const std::filesystem::path& path) const
+{
+    toml::array phases;
+
+    for (const auto& phase : phases_) {
+        phases.push_back(toml::table{
+            {"name"sv, phase.name},
+            {"seconds"sv, phase.seconds},
+        });
+    }
+
+    const toml::table report{
+        {"phases"sv, std::move(phases)},
+        {"counts"sv,
+         toml::table{
+             {"files"sv, static_cast<std::int64_t>(fileCount_)},
+             {"soulGemGroups"sv, static_cast<std::int64_t>(soulGemGroupCount_)},
+             {"forms"sv, static_cast<std::int64_t>(formCount_)},
+             {"errors"sv, static_cast<std::int64_t>(errorCount_)},
+         }},
+        {"memory"sv,
+         toml::table{
+             {"beforeCompaction"sv,
+              static_cast<std::int64_t>(memoryBeforeCompaction_)},
+             {"afterCompaction"sv,
+              static_cast<std::int64_t>(memoryAfterCompaction_)},
+         }},
+    };
+
+    std::ofstream file(path);
+
+    if (!file) {
+        return false;
+    }
+
+    file << toml::json_formatter{report} << '\n';
+
+    return static_cast<bool>(file);
+}
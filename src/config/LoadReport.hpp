@@ -0,0 +1,99 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <cstddef>
+
+#include "../utilities/Timer.hpp"
+
+/**
+ * @brief Collects timings and counts for each phase of the configuration load,
+ * so that slow startups can be narrowed down to a specific phase.
+ */
+class LoadReport {
+public:
+    struct Phase {
+        std::string name;
+        double seconds;
+    };
+
+    /**
+     * @brief Measures the time from construction to destruction (or stop())
+     * and records it as a phase of the owning report.
+     */
+    class ScopedPhase : public Timer {
+        LoadReport& report_;
+        std::string name_;
+        bool isStopped_ = false;
+
+    public:
+        explicit ScopedPhase(LoadReport& report, std::string name)
+            : report_(report)
+            , name_(std::move(name))
+        {}
+
+        ScopedPhase(const ScopedPhase&) = delete;
+        ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+        virtual ~ScopedPhase() { stop(); }
+
+        /**
+         * @brief Records the phase now instead of at destruction.
+         */
+        void stop()
+        {
+            if (!isStopped_) {
+                isStopped_ = true;
+                report_.addPhase(std::move(name_), elapsed());
+            }
+        }
+    };
+
+private:
+    std::vector<Phase> phases_;
+
+    std::size_t fileCount_ = 0;
+    std::size_t soulGemGroupCount_ = 0;
+    std::size_t formCount_ = 0;
+    std::size_t errorCount_ = 0;
+
+    std::size_t memoryBeforeCompaction_ = 0;
+    std::size_t memoryAfterCompaction_ = 0;
+
+public:
+    void addPhase(std::string name, double seconds);
+
+    void addFiles(const std::size_t count) noexcept { fileCount_ += count; }
+    void addSoulGemGroups(const std::size_t count) noexcept
+    {
+        soulGemGroupCount_ += count;
+    }
+    void addForms(const std::size_t count) noexcept { formCount_ += count; }
+    void addError() noexcept { ++errorCount_; }
+    /**
+     * @brief Records the estimated memory used by the configuration data
+     * before and after it was compacted, in bytes.
+     */
+    void setMemoryUsage(
+        const std::size_t beforeCompaction,
+        const std::size_t afterCompaction) noexcept
+    {
+        memoryBeforeCompaction_ = beforeCompaction;
+        memoryAfterCompaction_ = afterCompaction;
+    }
+
+    const std::vector<Phase>& phases() const noexcept { return phases_; }
+
+    void clear();
+
+    void print() const;
+    /**
+     * @brief Writes the report as JSON to the given path.
+     *
+     * @returns True if the file was written successfully.
+     */
+    bool writeJson(const std::filesystem::path& path) const;
+};
@@ -1,8 +1,8 @@
-#pragma once
-
-#include <exception>
-
-class ParseError : public std::runtime_error {
-public:
-    using std::runtime_error::runtime_error;
-};
+#pragma once
+
+#include <exception>
+
+class ParseError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
@@ -0,0 +1,56 @@
+#include "PluginNameTable.hpp"
+
+#include "../utilities/memoryutils.hpp"
+#include "../utilities/stringutils.hpp"
+
+PluginNameTable::IndexType
+    PluginNameTable::intern(const std::string_view pluginName)
+{
+    auto lowerName = getLowerString(pluginName);
+
+    std::lock_guard lock(mutex_);
+
+    if (const auto it = lowerNameToIndexMap_.find(lowerName);
+        it != lowerNameToIndexMap_.end()) {
+        return it->second;
+    }
+
+    const auto index = static_cast<IndexType>(names_.size());
+
+    names_.emplace_back(pluginName);
+    lowerNameToIndexMap_.emplace(std::move(lowerName), index);
+
+    return index;
+}
+
+const std::string& PluginNameTable::name(const IndexType index) const
+{
+    std::lock_guard lock(mutex_);
+
+    return names_.at(index);
+}
+
+std::size_t PluginNameTable::size() const
+{
+    std::lock_guard lock(mutex_);
+
+    return names_.size();
+}
+
+std::size_t PluginNameTable::estimateMemoryUsage() const
+{
+    std::lock_guard lock(mutex_);
+
+    std::size_t bytes = names_.size() * sizeof(std::string) +
+                        estimateHashMapMemoryUsage(lowerNameToIndexMap_);
+
+    for (const auto& name : names_) {
+        bytes += estimateHeapMemoryUsage(name);
+    }
+
+    for (const auto& [lowerName, index] : lowerNameToIndexMap_) {
+        bytes += estimateHeapMemoryUsage(lowerName);
+    }
+
+    return bytes;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Stores each distinct plugin name from the configuration files once.
+ *
+ * @details Plugin names are compared case-insensitively, so "Skyrim.esm" and
+ * "skyrim.esm" share the same index. The name returned for an index is the
+ * spelling it was first interned with.
+ */
+class PluginNameTable {
+public:
+    using IndexType = std::uint32_t;
+
+private:
+    // std::deque never moves its elements, so references returned by name()
+    // stay valid while other names are interned.
+    std::deque<std::string> names_;
+    std::unordered_map<std::string, IndexType> lowerNameToIndexMap_;
+    mutable std::mutex mutex_;
+
+    explicit PluginNameTable() = default;
+
+public:
+    PluginNameTable(const PluginNameTable&) = delete;
+    PluginNameTable(PluginNameTable&&) = delete;
+    PluginNameTable& operator=(const PluginNameTable&) = delete;
+    PluginNameTable& operator=(PluginNameTable&&) = delete;
+
+    static PluginNameTable& getInstance()
+    {
+        static PluginNameTable instance;
+
+        return instance;
+    }
+
+    /**
+     * @brief Returns the index of the given plugin name, adding it to the
+     * table if it isn't there yet.
+     */
+    IndexType intern(std::string_view pluginName);
+
+    const std::string& name(IndexType index) const;
+
+    std::size_t size() const;
+
+    /**
+     * @brief Returns a rough estimate of the heap memory used by the table, in
+     * bytes.
+     */
+    std::size_t estimateMemoryUsage() const;
+};
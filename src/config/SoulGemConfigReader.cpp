@@ -0,0 +1,805 @@
+#include "SoulGemConfigReader.hpp"
+
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <utility>
+
+#include <fmt/format.h>
+
+using namespace std::literals;
+
+namespace {
+    constexpr std::string_view SOULGEMS_KEY_("soulGems");
+
+    constexpr std::string_view ID_KEY_("id");
+    constexpr std::string_view ISREUSABLE_KEY_("isReusable");
+    constexpr std::string_view CAPACITY_KEY_("capacity");
+    constexpr std::string_view PRIORITY_KEY_("priority");
+    constexpr std::string_view MEMBERS_KEY_("members");
+
+    constexpr std::string_view VALUE_DELIMITERS_(" \t\r\n,]}#");
+
+    bool isBareKeyChar_(const char c) noexcept
+    {
+        return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') ||
+               (c >= '0' && c <= '9') || c == '_' || c == '-';
+    }
+
+    bool isDigit_(const char c) noexcept { return c >= '0' && c <= '9'; }
+
+    bool isDigitOfBase_(const char c, const int base) noexcept
+    {
+        switch (base) {
+        case 2:
+            return c == '0' || c == '1';
+        case 8:
+            return c >= '0' && c <= '7';
+        case 16:
+            return isDigit_(c) || (c >= 'a' && c <= 'f') ||
+                   (c >= 'A' && c <= 'F');
+        }
+
+        return isDigit_(c);
+    }
+
+    int toDigitValue_(const char c) noexcept
+    {
+        if (isDigit_(c)) {
+            return c - '0';
+        }
+
+        if (c >= 'a' && c <= 'f') {
+            return c - 'a' + 10;
+        }
+
+        return c - 'A' + 10;
+    }
+
+    bool isControlChar_(const char c) noexcept
+    {
+        const auto uc = static_cast<unsigned char>(c);
+        return (uc < 0x20 && c != '\t') || uc == 0x7F;
+    }
+
+    void appendUtf8_(std::string& str, const std::uint32_t codePoint)
+    {
+        if (codePoint < 0x80) {
+            str.push_back(static_cast<char>(codePoint));
+        } else if (codePoint < 0x800) {
+            str.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+            str.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        } else if (codePoint < 0x10000) {
+            str.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+            str.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+            str.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        } else {
+            str.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+            str.push_back(
+                static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+            str.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+            str.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        }
+    }
+} // namespace
+
+ConfigSyntaxError::ConfigSyntaxError(
+    const std::string_view description,
+    const SourcePosition position)
+    : ParseError(fmt::format(
+          FMT_STRING("{} (line {}, column {})"),
+          description,
+          position.line,
+          position.column))
+    , position(position)
+{}
+
+UnsupportedConfigSyntaxError::UnsupportedConfigSyntaxError(
+    const std::string_view description,
+    const SourcePosition position)
+    : ParseError(fmt::format(
+          FMT_STRING("{} (line {}, column {})"),
+          description,
+          position.line,
+          position.column))
+    , position(position)
+{}
+
+void SoulGemConfigReader::advance_()
+{
+    const char c = source_[offset_++];
+
+    if (c == '\n') {
+        ++position_.line;
+        position_.column = 1;
+    } else if (
+        offset_ >= source_.size() ||
+        (static_cast<unsigned char>(source_[offset_]) & 0xC0) != 0x80) {
+        // Only count the column once the whole code point is consumed.
+        ++position_.column;
+    }
+}
+
+void SoulGemConfigReader::throwSyntaxError_(
+    const std::string_view description) const
+{
+    throw ConfigSyntaxError(description, position_);
+}
+
+void SoulGemConfigReader::throwUnsupportedError_(
+    const std::string_view description) const
+{
+    throw UnsupportedConfigSyntaxError(description, position_);
+}
+
+void SoulGemConfigReader::skipWhitespace_()
+{
+    while (peek_() == ' ' || peek_() == '\t') {
+        advance_();
+    }
+}
+
+void SoulGemConfigReader::skipComment_()
+{
+    if (peek_() != '#') {
+        return;
+    }
+
+    while (!isAtEnd_() && peek_() != '\n' && peek_() != '\r') {
+        advance_();
+    }
+}
+
+void SoulGemConfigReader::skipBlank_()
+{
+    while (true) {
+        skipWhitespace_();
+        skipComment_();
+
+        if (peek_() == '\n') {
+            advance_();
+        } else if (peek_() == '\r') {
+            if (peek_(1) != '\n') {
+                throwSyntaxError_("Expected a newline after carriage return"sv);
+            }
+
+            advance_();
+            advance_();
+        } else {
+            return;
+        }
+    }
+}
+
+void SoulGemConfigReader::expectLineEnd_()
+{
+    skipWhitespace_();
+    skipComment_();
+
+    if (isAtEnd_()) {
+        return;
+    }
+
+    if (peek_() == '\n') {
+        advance_();
+    } else if (peek_() == '\r' && peek_(1) == '\n') {
+        advance_();
+        advance_();
+    } else {
+        throwSyntaxError_("Expected a newline"sv);
+    }
+}
+
+std::string SoulGemConfigReader::parseKey_()
+{
+    if (isAtString_()) {
+        return parseString_();
+    }
+
+    const auto begin = offset_;
+
+    while (isBareKeyChar_(peek_())) {
+        advance_();
+    }
+
+    if (begin == offset_) {
+        throwSyntaxError_("Expected a key"sv);
+    }
+
+    return std::string(source_.substr(begin, offset_ - begin));
+}
+
+std::string SoulGemConfigReader::parseBasicString_()
+{
+    std::string result;
+
+    advance_(); // Opening quote.
+
+    while (true) {
+        if (isAtEnd_() || peek_() == '\n' || peek_() == '\r') {
+            throwSyntaxError_("Unterminated string"sv);
+        }
+
+        const char c = peek_();
+
+        if (c == '"') {
+            advance_();
+            return result;
+        }
+
+        if (isControlChar_(c)) {
+            throwSyntaxError_("Control characters are not allowed in strings"sv);
+        }
+
+        if (c != '\\') {
+            result.push_back(c);
+            advance_();
+            continue;
+        }
+
+        const auto escapePosition = position_;
+        advance_(); // Backslash.
+
+        switch (peek_()) {
+        case 'b':
+            result.push_back('\b');
+            break;
+        case 't':
+            result.push_back('\t');
+            break;
+        case 'n':
+            result.push_back('\n');
+            break;
+        case 'f':
+            result.push_back('\f');
+            break;
+        case 'r':
+            result.push_back('\r');
+            break;
+        case '"':
+            result.push_back('"');
+            break;
+        case '\\':
+            result.push_back('\\');
+            break;
+        case 'u':
+        case 'U':
+            {
+                const std::size_t digitCount = peek_() == 'u' ? 4 : 8;
+                std::uint32_t codePoint = 0;
+
+                advance_();
+
+                for (std::size_t i = 0; i < digitCount; ++i) {
+                    if (!isDigitOfBase_(peek_(), 16)) {
+                        throw ConfigSyntaxError(
+                            "Invalid unicode escape sequence"sv,
+                            escapePosition);
+                    }
+
+                    codePoint = codePoint * 16 + toDigitValue_(peek_());
+                    advance_();
+                }
+
+                if (codePoint > 0x10FFFF ||
+                    (codePoint >= 0xD800 && codePoint <= 0xDFFF)) {
+                    throw ConfigSyntaxError(
+                        "Escape sequence is not a valid unicode scalar value"sv,
+                        escapePosition);
+                }
+
+                appendUtf8_(result, codePoint);
+                continue;
+            }
+        default:
+            throw ConfigSyntaxError("Invalid escape sequence"sv, escapePosition);
+        }
+
+        advance_();
+    }
+}
+
+std::string SoulGemConfigReader::parseLiteralString_()
+{
+    advance_(); // Opening quote.
+
+    const auto begin = offset_;
+
+    while (peek_() != '\'') {
+        if (isAtEnd_() || peek_() == '\n' || peek_() == '\r') {
+            throwSyntaxError_("Unterminated string"sv);
+        }
+
+        if (isControlChar_(peek_())) {
+            throwSyntaxError_("Control characters are not allowed in strings"sv);
+        }
+
+        advance_();
+    }
+
+    const auto end = offset_;
+    advance_(); // Closing quote.
+
+    return std::string(source_.substr(begin, end - begin));
+}
+
+std::string SoulGemConfigReader::parseString_()
+{
+    if (startsWith_("\"\"\""sv) || startsWith_("'''"sv)) {
+        throwUnsupportedError_("Multi-line strings are not supported"sv);
+    }
+
+    return peek_() == '"' ? parseBasicString_() : parseLiteralString_();
+}
+
+std::int64_t SoulGemConfigReader::parseInteger_()
+{
+    const auto tokenEnd = source_.find_first_of(VALUE_DELIMITERS_, offset_);
+    const auto token = source_.substr(
+        offset_,
+        tokenEnd == std::string_view::npos ? std::string_view::npos
+                                           : tokenEnd - offset_);
+
+    const auto tokenPosition = position_;
+    const auto throwInvalidInteger = [&]() {
+        throw ConfigSyntaxError("Invalid integer"sv, tokenPosition);
+    };
+
+    std::size_t index = 0;
+    bool isNegative = false;
+
+    if (token[0] == '+' || token[0] == '-') {
+        isNegative = token[0] == '-';
+        ++index;
+    }
+
+    int base = 10;
+
+    if (token.size() > index + 1 && token[index] == '0' &&
+        (token[index + 1] == 'x' || token[index + 1] == 'o' ||
+         token[index + 1] == 'b')) {
+        if (index > 0) {
+            throwInvalidInteger();
+        }
+
+        base = token[1] == 'x' ? 16 : (token[1] == 'o' ? 8 : 2);
+        index = 2;
+    } else {
+        const auto rest = token.substr(index);
+
+        if (rest.starts_with("inf"sv) || rest.starts_with("nan"sv) ||
+            token.find_first_of(".eE"sv) != std::string_view::npos) {
+            throwUnsupportedError_("Floating-point values are not supported"sv);
+        }
+
+        if (token.find(':') != std::string_view::npos ||
+            token.find('-', 1) != std::string_view::npos) {
+            throwUnsupportedError_("Date and time values are not supported"sv);
+        }
+
+        if (rest.size() > 1 && rest[0] == '0') {
+            throw ConfigSyntaxError(
+                "Leading zeros are not allowed in integers"sv,
+                tokenPosition);
+        }
+    }
+
+    // Digits with optional single underscores between them.
+    std::uint64_t magnitude = 0;
+    bool isPreviousDigit = false;
+
+    if (index >= token.size()) {
+        throwInvalidInteger();
+    }
+
+    for (; index < token.size(); ++index) {
+        const char c = token[index];
+
+        if (c == '_') {
+            if (!isPreviousDigit) {
+                throwInvalidInteger();
+            }
+
+            isPreviousDigit = false;
+            continue;
+        }
+
+        if (!isDigitOfBase_(c, base)) {
+            throwInvalidInteger();
+        }
+
+        const auto digit = static_cast<std::uint64_t>(toDigitValue_(c));
+
+        if (magnitude > (std::numeric_limits<std::uint64_t>::max() - digit) /
+                            static_cast<std::uint64_t>(base)) {
+            throw ConfigSyntaxError("Integer is out of range"sv, tokenPosition);
+        }
+
+        magnitude = magnitude * base + digit;
+        isPreviousDigit = true;
+    }
+
+    if (!isPreviousDigit) {
+        throwInvalidInteger();
+    }
+
+    constexpr auto maxValue =
+        static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max());
+
+    if (magnitude > maxValue + (isNegative ? 1 : 0)) {
+        throw ConfigSyntaxError("Integer is out of range"sv, tokenPosition);
+    }
+
+    for (std::size_t i = 0; i < token.size(); ++i) {
+        advance_();
+    }
+
+    return isNegative ? static_cast<std::int64_t>(0 - magnitude)
+                      : static_cast<std::int64_t>(magnitude);
+}
+
+bool SoulGemConfigReader::parseBoolean_()
+{
+    if (startsWith_("true"sv)) {
+        for (std::size_t i = 0; i < "true"sv.size(); ++i) {
+            advance_();
+        }
+
+        return true;
+    }
+
+    for (std::size_t i = 0; i < "false"sv.size(); ++i) {
+        advance_();
+    }
+
+    return false;
+}
+
+bool SoulGemConfigReader::isAtString_() const noexcept
+{
+    return peek_() == '"' || peek_() == '\'';
+}
+
+bool SoulGemConfigReader::isAtInteger_() const noexcept
+{
+    return isDigit_(peek_()) ||
+           ((peek_() == '+' || peek_() == '-') && isDigit_(peek_(1)));
+}
+
+bool SoulGemConfigReader::isAtBoolean_() const noexcept
+{
+    return startsWith_("true"sv) || startsWith_("false"sv);
+}
+
+void SoulGemConfigReader::skipValue_()
+{
+    const char c = peek_();
+
+    if (isAtString_()) {
+        parseString_();
+    } else if (c == '[') {
+        parseArray_([this](std::size_t) { skipValue_(); });
+    } else if (c == '{') {
+        parseInlineTable_([this](const std::string&) { skipValue_(); });
+    } else if (isAtBoolean_()) {
+        parseBoolean_();
+    } else if (isDigit_(c) || c == '+' || c == '-') {
+        parseInteger_();
+    } else if (startsWith_("inf"sv) || startsWith_("nan"sv)) {
+        throwUnsupportedError_("Floating-point values are not supported"sv);
+    } else {
+        throwSyntaxError_("Expected a value"sv);
+    }
+}
+
+void SoulGemConfigReader::parseArray_(
+    const std::function<void(std::size_t)>& onElement)
+{
+    advance_(); // Opening bracket.
+
+    for (std::size_t index = 0;; ++index) {
+        skipBlank_();
+
+        if (peek_() == ']') {
+            advance_();
+            return;
+        }
+
+        if (isAtEnd_()) {
+            throwSyntaxError_("Unterminated array"sv);
+        }
+
+        onElement(index);
+        skipBlank_();
+
+        if (peek_() == ',') {
+            advance_();
+        } else if (peek_() == ']') {
+            advance_();
+            return;
+        } else {
+            throwSyntaxError_("Expected ',' or ']'"sv);
+        }
+    }
+}
+
+void SoulGemConfigReader::parseInlineTable_(
+    const std::function<void(const std::string&)>& onKeyValue)
+{
+    std::unordered_set<std::string> keys;
+
+    advance_(); // Opening brace.
+    skipWhitespace_();
+
+    if (peek_() == '}') {
+        advance_();
+        return;
+    }
+
+    while (true) {
+        const auto keyPosition = position_;
+        const auto key = parseKey_();
+
+        skipWhitespace_();
+
+        if (peek_() == '.') {
+            throwUnsupportedError_("Dotted keys are not supported"sv);
+        }
+
+        if (peek_() != '=') {
+            throwSyntaxError_("Expected '='"sv);
+        }
+
+        advance_();
+        skipWhitespace_();
+
+        if (!keys.insert(key).second) {
+            throw UnsupportedConfigSyntaxError(
+                "Duplicate key in inline table"sv,
+                keyPosition);
+        }
+
+        onKeyValue(key);
+        skipWhitespace_();
+
+        if (peek_() == ',') {
+            advance_();
+            skipWhitespace_();
+        } else if (peek_() == '}') {
+            advance_();
+            return;
+        } else {
+            throwSyntaxError_("Expected ',' or '}'"sv);
+        }
+    }
+}
+
+void SoulGemConfigReader::parseGroupEntry_(
+    const std::string& key,
+    SoulGemGroup::Fields& fields)
+{
+    // Entries of the wrong type are skipped and left empty, so the soul gem
+    // group reports them the same way as when reading from a TOML table.
+    if (key == ID_KEY_ && isAtString_()) {
+        fields.id = parseString_();
+    } else if (key == CAPACITY_KEY_ && isAtInteger_()) {
+        fields.capacity = parseInteger_();
+    } else if (key == ISREUSABLE_KEY_ && isAtBoolean_()) {
+        fields.isReusable = parseBoolean_();
+    } else if (key == PRIORITY_KEY_ && isAtString_()) {
+        fields.priority = parseString_();
+    } else if (key == MEMBERS_KEY_ && peek_() == '[') {
+        fields.members = parseMembers_();
+    } else {
+        skipValue_();
+    }
+}
+
+std::vector<SoulGemGroup::Fields::MemberEntry>
+    SoulGemConfigReader::parseMembers_()
+{
+    using Fields = SoulGemGroup::Fields;
+
+    std::vector<Fields::MemberEntry> members;
+
+    parseArray_([&, this](std::size_t) {
+        if (peek_() == '[') {
+            Fields::FormIdEntry formId;
+
+            parseArray_([&, this](const std::size_t index) {
+                if (index == 0 && isAtInteger_()) {
+                    formId.id = parseInteger_();
+                } else if (index == 1 && isAtString_()) {
+                    formId.pluginName = parseString_();
+                } else {
+                    skipValue_();
+                }
+            });
+
+            members.emplace_back(std::move(formId));
+        } else if (isAtString_()) {
+            members.emplace_back(parseString_());
+        } else {
+            skipValue_();
+            members.emplace_back(std::monostate());
+        }
+    });
+
+    return members;
+}
+
+void SoulGemConfigReader::parseSoulGemsArray_(
+    const GroupCallback& onGroup,
+    const InvalidEntryCallback& onInvalidEntry)
+{
+    parseArray_([&, this](std::size_t) {
+        const auto elementPosition = position_;
+
+        if (peek_() == '{') {
+            SoulGemGroup::Fields fields;
+
+            parseInlineTable_([&, this](const std::string& key) {
+                parseGroupEntry_(key, fields);
+            });
+
+            onGroup(std::move(fields), elementPosition);
+        } else {
+            skipValue_();
+            onInvalidEntry(elementPosition);
+        }
+    });
+}
+
+void SoulGemConfigReader::defineKey_(
+    const std::string& key,
+    const SourcePosition keyPosition)
+{
+    if (!currentTableKeys_.insert(key).second) {
+        throw UnsupportedConfigSyntaxError("Duplicate key"sv, keyPosition);
+    }
+}
+
+void SoulGemConfigReader::read(
+    const GroupCallback& onGroup,
+    const InvalidEntryCallback& onInvalidEntry)
+{
+    // Skip the UTF-8 byte order mark if present.
+    if (startsWith_("\xEF\xBB\xBF"sv)) {
+        offset_ += 3;
+    }
+
+    Context context = Context::Root;
+    SoulGemGroup::Fields currentGroup;
+    SourcePosition currentGroupPosition;
+
+    const auto finishCurrentGroup = [&]() {
+        if (context == Context::SoulGemGroup) {
+            onGroup(std::move(currentGroup), currentGroupPosition);
+            currentGroup = SoulGemGroup::Fields();
+        }
+    };
+
+    while (true) {
+        skipBlank_();
+
+        if (isAtEnd_()) {
+            break;
+        }
+
+        if (peek_() == '[') {
+            finishCurrentGroup();
+
+            const auto headerPosition = position_;
+            const bool isArrayTable = peek_(1) == '[';
+
+            advance_();
+            if (isArrayTable) {
+                advance_();
+            }
+
+            skipWhitespace_();
+            const auto name = parseKey_();
+            skipWhitespace_();
+
+            if (peek_() == '.') {
+                throwUnsupportedError_("Dotted table names are not supported"sv);
+            }
+
+            if (peek_() != ']' || (isArrayTable && peek_(1) != ']')) {
+                throwSyntaxError_(
+                    isArrayTable ? "Expected ']]'"sv : "Expected ']'"sv);
+            }
+
+            advance_();
+            if (isArrayTable) {
+                advance_();
+            }
+
+            expectLineEnd_();
+            currentTableKeys_.clear();
+
+            if (isArrayTable) {
+                if (definedTables_.contains(name)) {
+                    throw UnsupportedConfigSyntaxError(
+                        "Redefinition of table as array of tables"sv,
+                        headerPosition);
+                }
+
+                arrayTables_.insert(name);
+
+                if (name == SOULGEMS_KEY_) {
+                    context = Context::SoulGemGroup;
+                    currentGroupPosition = headerPosition;
+                } else {
+                    context = Context::Other;
+                }
+            } else {
+                if (arrayTables_.contains(name) ||
+                    !definedTables_.insert(name).second) {
+                    throw UnsupportedConfigSyntaxError(
+                        "Redefinition of table"sv,
+                        headerPosition);
+                }
+
+                context = Context::Other;
+            }
+
+            continue;
+        }
+
+        const auto keyPosition = position_;
+        const auto key = parseKey_();
+
+        skipWhitespace_();
+
+        if (peek_() == '.') {
+            throwUnsupportedError_("Dotted keys are not supported"sv);
+        }
+
+        if (peek_() != '=') {
+            throwSyntaxError_("Expected '='"sv);
+        }
+
+        advance_();
+        skipWhitespace_();
+        defineKey_(key, keyPosition);
+
+        switch (context) {
+        case Context::Root:
+            // Top-level keys can't be redefined as tables later on.
+            definedTables_.insert(key);
+
+            if (key == SOULGEMS_KEY_ && peek_() == '[') {
+                parseSoulGemsArray_(onGroup, onInvalidEntry);
+            } else {
+                skipValue_();
+            }
+            break;
+        case Context::SoulGemGroup:
+            parseGroupEntry_(key, currentGroup);
+            break;
+        case Context::Other:
+            skipValue_();
+            break;
+        }
+
+        expectLineEnd_();
+    }
+
+    finishCurrentGroup();
+}
+
+std::string SoulGemConfigReader::readFile(const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ios::binary);
+
+    if (!file) {
+        throw ParseError(fmt::format(
+            FMT_STRING("File could not be opened for reading: {}"),
+            path.string()));
+    }
+
+    return std::string(
+        std::istreambuf_iterator<char>(file),
+        std::istreambuf_iterator<char>());
+}
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include "ParseError.hpp"
+#include "SoulGemGroup.hpp"
+
+/**
+ * @brief A position in a configuration file. Lines and columns start at 1, and
+ * columns are counted in code points.
+ */
+struct SourcePosition {
+    std::size_t line = 1;
+    std::size_t column = 1;
+};
+
+/**
+ * @brief Thrown when the configuration file is not valid TOML.
+ */
+class ConfigSyntaxError : public ParseError {
+public:
+    const SourcePosition position;
+
+    explicit ConfigSyntaxError(
+        std::string_view description,
+        SourcePosition position);
+};
+
+/**
+ * @brief Thrown when the configuration file uses TOML syntax the reader does
+ * not handle (e.g. floats, dates, multi-line strings or dotted keys). The file
+ * should be read with the full TOML parser instead.
+ */
+class UnsupportedConfigSyntaxError : public ParseError {
+public:
+    const SourcePosition position;
+
+    explicit UnsupportedConfigSyntaxError(
+        std::string_view description,
+        SourcePosition position);
+};
+
+/**
+ * @brief Reads the soul gem groups of a YASTM_*.toml file in a single pass over
+ * the file contents, without building a TOML document.
+ *
+ * @details Only the "soulGems" array (as [[soulGems]] tables or as an array of
+ * inline tables) is extracted. Everything else is checked for syntax and then
+ * skipped.
+ */
+class SoulGemConfigReader {
+public:
+    using GroupCallback =
+        std::function<void(SoulGemGroup::Fields&&, SourcePosition)>;
+    using InvalidEntryCallback = std::function<void(SourcePosition)>;
+
+private:
+    enum class Context {
+        Root,
+        SoulGemGroup,
+        Other,
+    };
+
+    std::string_view source_;
+    std::size_t offset_ = 0;
+    SourcePosition position_;
+
+    std::unordered_set<std::string> definedTables_;
+    std::unordered_set<std::string> arrayTables_;
+    std::unordered_set<std::string> currentTableKeys_;
+
+    [[nodiscard]] bool isAtEnd_() const noexcept
+    {
+        return offset_ >= source_.size();
+    }
+    [[nodiscard]] char peek_(std::size_t lookahead = 0) const noexcept
+    {
+        return offset_ + lookahead < source_.size()
+                   ? source_[offset_ + lookahead]
+                   : '\0';
+    }
+    [[nodiscard]] bool startsWith_(std::string_view str) const noexcept
+    {
+        return source_.substr(offset_).starts_with(str);
+    }
+    void advance_();
+
+    [[noreturn]] void throwSyntaxError_(std::string_view description) const;
+    [[noreturn]] void
+        throwUnsupportedError_(std::string_view description) const;
+
+    void skipWhitespace_();
+    /**
+     * @brief Skips whitespace, comments and newlines.
+     */
+    void skipBlank_();
+    void skipComment_();
+    /**
+     * @brief Expects the end of the current line (after optional whitespace
+     * and comment).
+     */
+    void expectLineEnd_();
+
+    std::string parseKey_();
+    std::string parseBasicString_();
+    std::string parseLiteralString_();
+    std::string parseString_();
+    std::int64_t parseInteger_();
+    bool parseBoolean_();
+
+    [[nodiscard]] bool isAtString_() const noexcept;
+    [[nodiscard]] bool isAtInteger_() const noexcept;
+    [[nodiscard]] bool isAtBoolean_() const noexcept;
+
+    void skipValue_();
+    void parseArray_(const std::function<void(std::size_t)>& onElement);
+    void parseInlineTable_(
+        const std::function<void(const std::string&)>& onKeyValue);
+
+    void parseGroupEntry_(const std::string& key, SoulGemGroup::Fields& fields);
+    std::vector<SoulGemGroup::Fields::MemberEntry> parseMembers_();
+    void parseSoulGemsArray_(
+        const GroupCallback& onGroup,
+        const InvalidEntryCallback& onInvalidEntry);
+
+    void defineKey_(const std::string& key, SourcePosition keyPosition);
+
+public:
+    explicit SoulGemConfigReader(std::string_view source)
+        : source_(source)
+    {}
+
+    /**
+     * @brief Reads the file contents, calling onGroup for every soul gem group
+     * and onInvalidEntry for every "soulGems" array element that isn't a table.
+     *
+     * @throws ConfigSyntaxError The file is not valid TOML.
+     * @throws UnsupportedConfigSyntaxError The file uses syntax the reader
+     * does not handle.
+     */
+    void read(
+        const GroupCallback& onGroup,
+        const InvalidEntryCallback& onInvalidEntry);
+
+    /**
+     * @brief Reads the contents of the given file into a string.
+     *
+     * @throws ParseError The file could not be read.
+     */
+    static std::string readFile(const std::filesystem::path& path);
+};
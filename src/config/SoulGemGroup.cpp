@@ -1,187 +1,240 @@
-#include "SoulGemGroup.hpp"
-
-#include <concepts>
-#include <iterator>
-#include <queue>
-#include <string>
-#include <utility>
-
-#include <cassert>
-
-#include "../global.hpp"
-#include "../utilities/algorithms.hpp"
-#include "FormId.hpp"
-#include "ParseError.hpp"
-
-using namespace std::literals;
-
-namespace {
-    constexpr std::string_view ID_KEY_("id");
-    constexpr std::string_view ISREUSABLE_KEY_("isReusable");
-    constexpr std::string_view CAPACITY_KEY_("capacity");
-    constexpr std::string_view PRIORITY_KEY_("priority");
-    constexpr std::string_view MEMBERS_KEY_("members");
-
-    template <std::integral T>
-    constexpr SoulGemCapacity toSoulGemCapacityFromConfig_(const T capacity)
-    {
-        switch (capacity) {
-        case 1:
-            return SoulGemCapacity::Petty;
-        case 2:
-            return SoulGemCapacity::Lesser;
-        case 3:
-            return SoulGemCapacity::Common;
-        case 4:
-            return SoulGemCapacity::Greater;
-        case 5:
-            return SoulGemCapacity::Grand;
-        case 6:
-            return SoulGemCapacity::Black;
-        }
-
-        throw ParseError(fmt::format(
-            FMT_STRING("Invalid value for entry '{}'"),
-            CAPACITY_KEY_));
-    }
-
-    std::size_t
-        getExpectedMemberCountForCapacity_(const SoulGemCapacity capacity)
-    {
-        switch (capacity) {
-        case SoulGemCapacity::Dual:
-            return 6;
-        case SoulGemCapacity::Black:
-            return 2;
-        }
-
-        return capacity + 2;
-    }
-
-    std::string parseId_(const toml::table& table)
-    {
-        const auto value = table[ID_KEY_].as_string();
-
-        if (value == nullptr) {
-            throw ParseError(fmt::format(
-                FMT_STRING("Expected string entry named '{}'"),
-                ID_KEY_));
-        }
-
-        return value->get();
-    }
-
-    SoulGemCapacity parseCapacity_(const toml::table& table)
-    {
-        const auto value = table[CAPACITY_KEY_].as_integer();
-
-        if (value == nullptr) {
-            throw ParseError(fmt::format(
-                FMT_STRING("Expected integer entry named '{}'"),
-                CAPACITY_KEY_));
-        }
-
-        const auto capacity = toSoulGemCapacityFromConfig_(value->get());
-
-        // The dual status of soul gems is determined by the code and not
-        // provided directly by configuration files, so if the parsed user input
-        // is "dual", it's a bug.
-        assert(capacity != SoulGemCapacity::Dual);
-
-        return capacity;
-    }
-
-    bool parseIsReusable_(const toml::table& table)
-    {
-        return table[ISREUSABLE_KEY_].value_or(false);
-    }
-
-    LoadPriority parsePriority_(const toml::table& table)
-    {
-        const auto value = table[PRIORITY_KEY_].value_or("auto"sv);
-
-        const LoadPriority priority = fromLoadPriorityString(value);
-
-        if (priority == LoadPriority::Invalid) {
-            throw ParseError(fmt::format(
-                FMT_STRING("Invalid value for entry '{}'"),
-                PRIORITY_KEY_));
-        }
-
-        return priority;
-    }
-
-    SoulGemGroup::MemberList
-        parseMembers_(const toml::table& table, const SoulGemCapacity capacity)
-    {
-        const auto value = table[MEMBERS_KEY_].as_array();
-
-        if (value == nullptr || value->empty()) {
-            throw ParseError(fmt::format(
-                FMT_STRING("Expected non-empty array entry named '{}'"),
-                MEMBERS_KEY_));
-        }
-
-        SoulGemGroup::MemberList members;
-        std::size_t index = 0;
-
-        for (const toml::node& elem : *value) {
-            try {
-                elem.visit([&](auto&& el) {
-                    if constexpr (toml::is_array<decltype(el)>) {
-                        members.emplace_back(std::in_place_type<FormId>, el);
-                    } else if constexpr (toml::is_string<decltype(el)>) {
-                        members.emplace_back(
-                            std::in_place_type<std::string>,
-                            el);
-                    } else {
-                        throw ParseError(fmt::format(
-                            FMT_STRING("{}[{}] is not an array"),
-                            MEMBERS_KEY_,
-                            index));
-                    }
-                });
-            } catch (...) {
-                std::throw_with_nested(ParseError(fmt::format(
-                    FMT_STRING("Invalid form ID entry at {}[{}]"sv),
-                    MEMBERS_KEY_,
-                    index)));
-            }
-            ++index;
-        }
-
-        if (!areAllUnique(members.cbegin(), members.cend())) {
-            throw ParseError(fmt::format(
-                FMT_STRING("Duplicate values in '{}' array"),
-                MEMBERS_KEY_));
-        }
-
-        if (const auto expectedMemberCount =
-                getExpectedMemberCountForCapacity_(capacity);
-            expectedMemberCount != members.size()) {
-            throw ParseError(fmt::format(
-                FMT_STRING("Invalid number of members in '{}' array"),
-                MEMBERS_KEY_));
-        }
-
-        return members;
-    }
-} // namespace
-
-SoulGemGroup::SoulGemGroup(const toml::table& table)
-{
-    // The nested error includes the ID value, which isn't present if this
-    // fails, so we do this before the try...catch.
-    id_ = parseId_(table);
-
-    try {
-        capacity_ = parseCapacity_(table);
-        isReusable_ = parseIsReusable_(table);
-        priority_ = parsePriority_(table);
-        members_ = parseMembers_(table, capacity_);
-    } catch (...) {
-        std::throw_with_nested(SoulGemGroupError(fmt::format(
-            FMT_STRING("Error while parsing soul gem group \"{}\":"sv),
-            id_)));
-    }
-}
+#include "SoulGemGroup.hpp"
+
+#include <concepts>
+#include <iterator>
+#include <queue>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include <cassert>
+
+#include "../global.hpp"
+#include "../utilities/algorithms.hpp"
+#include "FormId.hpp"
+#include "ParseError.hpp"
+
+using namespace std::literals;
+
+namespace {
+    constexpr std::string_view ID_KEY_("id");
+    constexpr std::string_view ISREUSABLE_KEY_("isReusable");
+    constexpr std::string_view CAPACITY_KEY_("capacity");
+    constexpr std::string_view PRIORITY_KEY_("priority");
+    constexpr std::string_view MEMBERS_KEY_("members");
+
+    template <std::integral T>
+    constexpr SoulGemCapacity toSoulGemCapacityFromConfig_(const T capacity)
+    {
+        switch (capacity) {
+        case 1:
+            return SoulGemCapacity::Petty;
+        case 2:
+            return SoulGemCapacity::Lesser;
+        case 3:
+            return SoulGemCapacity::Common;
+        case 4:
+            return SoulGemCapacity::Greater;
+        case 5:
+            return SoulGemCapacity::Grand;
+        case 6:
+            return SoulGemCapacity::Black;
+        }
+
+        throw ParseError(fmt::format(
+            FMT_STRING("Invalid value for entry '{}'"),
+            CAPACITY_KEY_));
+    }
+
+    std::size_t
+        getExpectedMemberCountForCapacity_(const SoulGemCapacity capacity)
+    {
+        switch (capacity) {
+        case SoulGemCapacity::Dual:
+            return 6;
+        case SoulGemCapacity::Black:
+            return 2;
+        }
+
+        return capacity + 2;
+    }
+
+    std::string parseId_(const SoulGemGroup::Fields& fields)
+    {
+        if (!fields.id.has_value()) {
+            throw ParseError(fmt::format(
+                FMT_STRING("Expected string entry named '{}'"),
+                ID_KEY_));
+        }
+
+        return *fields.id;
+    }
+
+    SoulGemCapacity parseCapacity_(const SoulGemGroup::Fields& fields)
+    {
+        if (!fields.capacity.has_value()) {
+            throw ParseError(fmt::format(
+                FMT_STRING("Expected integer entry named '{}'"),
+                CAPACITY_KEY_));
+        }
+
+        const auto capacity = toSoulGemCapacityFromConfig_(*fields.capacity);
+
+        // The dual status of soul gems is determined by the code and not
+        // provided directly by configuration files, so if the parsed user input
+        // is "dual", it's a bug.
+        assert(capacity != SoulGemCapacity::Dual);
+
+        return capacity;
+    }
+
+    bool parseIsReusable_(const SoulGemGroup::Fields& fields)
+    {
+        return fields.isReusable.value_or(false);
+    }
+
+    LoadPriority parsePriority_(const SoulGemGroup::Fields& fields)
+    {
+        const LoadPriority priority =
+            fromLoadPriorityString(fields.priority.value_or("auto"s));
+
+        if (priority == LoadPriority::Invalid) {
+            throw ParseError(fmt::format(
+                FMT_STRING("Invalid value for entry '{}'"),
+                PRIORITY_KEY_));
+        }
+
+        return priority;
+    }
+
+    SoulGemGroup::MemberList parseMembers_(
+        const SoulGemGroup::Fields& fields,
+        const SoulGemCapacity capacity)
+    {
+        using Fields = SoulGemGroup::Fields;
+
+        if (!fields.members.has_value() || fields.members->empty()) {
+            throw ParseError(fmt::format(
+                FMT_STRING("Expected non-empty array entry named '{}'"),
+                MEMBERS_KEY_));
+        }
+
+        SoulGemGroup::MemberList members;
+        std::size_t index = 0;
+
+        for (const auto& entry : *fields.members) {
+            try {
+                std::visit(
+                    [&](auto&& entry) {
+                        using T = std::decay_t<decltype(entry)>;
+
+                        if constexpr (std::is_same_v<T, Fields::FormIdEntry>) {
+                            members.emplace_back(
+                                std::in_place_type<FormId>,
+                                entry.id,
+                                entry.pluginName);
+                        } else if constexpr (std::is_same_v<T, std::string>) {
+                            members.emplace_back(
+                                std::in_place_type<std::string>,
+                                entry);
+                        } else {
+                            throw ParseError(fmt::format(
+                                FMT_STRING("{}[{}] is not an array"),
+                                MEMBERS_KEY_,
+                                index));
+                        }
+                    },
+                    entry);
+            } catch (...) {
+                std::throw_with_nested(ParseError(fmt::format(
+                    FMT_STRING("Invalid form ID entry at {}[{}]"sv),
+                    MEMBERS_KEY_,
+                    index)));
+            }
+            ++index;
+        }
+
+        if (!areAllUnique(members.cbegin(), members.cend())) {
+            throw ParseError(fmt::format(
+                FMT_STRING("Duplicate values in '{}' array"),
+                MEMBERS_KEY_));
+        }
+
+        if (const auto expectedMemberCount =
+                getExpectedMemberCountForCapacity_(capacity);
+            expectedMemberCount != members.size()) {
+            throw ParseError(fmt::format(
+                FMT_STRING("Invalid number of members in '{}' array"),
+                MEMBERS_KEY_));
+        }
+
+        return members;
+    }
+
+    /**
+     * @brief Extracts the soul gem group entries from a TOML table.
+     */
+    SoulGemGroup::Fields toFields_(const toml::table& table)
+    {
+        using Fields = SoulGemGroup::Fields;
+
+        Fields fields;
+
+        fields.id = table[ID_KEY_].value_exact<std::string>();
+        fields.capacity = table[CAPACITY_KEY_].value_exact<std::int64_t>();
+        fields.isReusable = table[ISREUSABLE_KEY_].value_exact<bool>();
+        fields.priority = table[PRIORITY_KEY_].value_exact<std::string>();
+
+        if (const auto members = table[MEMBERS_KEY_].as_array();
+            members != nullptr) {
+            auto& memberEntries = fields.members.emplace();
+
+            for (const toml::node& elem : *members) {
+                if (const auto arr = elem.as_array(); arr != nullptr) {
+                    Fields::FormIdEntry formId;
+
+                    if (const auto id = arr->get(0); id != nullptr) {
+                        formId.id = id->value_exact<std::int64_t>();
+                    }
+
+                    if (const auto pluginName = arr->get(1);
+                        pluginName != nullptr) {
+                        formId.pluginName =
+                            pluginName->value_exact<std::string>();
+                    }
+
+                    memberEntries.emplace_back(std::move(formId));
+                } else if (const auto str = elem.as_string(); str != nullptr) {
+                    memberEntries.emplace_back(str->get());
+                } else {
+                    memberEntries.emplace_back(std::monostate());
+                }
+            }
+        }
+
+        return fields;
+    }
+} // namespace
+
+SoulGemGroup::SoulGemGroup(const toml::table& table)
+    : SoulGemGroup(toFields_(table))
+{}
+
+SoulGemGroup::SoulGemGroup(const Fields& fields)
+{
+    // The nested error includes the ID value, which isn't present if this
+    // fails, so we do this before the try...catch.
+    id_ = parseId_(fields);
+
+    try {
+        capacity_ = parseCapacity_(fields);
+        isReusable_ = parseIsReusable_(fields);
+        priority_ = parsePriority_(fields);
+        members_ = parseMembers_(fields, capacity_);
+    } catch (...) {
+        std::throw_with_nested(SoulGemGroupError(fmt::format(
+            FMT_STRING("Error while parsing soul gem group \"{}\":"sv),
+            id_)));
+    }
+}
@@ -0,0 +1,247 @@
+#include "consolidate.hpp"
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+#include <RE/A/Actor.h>
+#include <RE/T/TESSoulGem.h>
+
+#include "../global.hpp"
+#include "../SoulValue.hpp"
+#include "../config/configutilities.hpp"
+#include "../config/ConfigKey/BoolConfigKey.hpp"
+#include "../config/SoulGemMap.hpp"
+#include "../config/YASTMConfig.hpp"
+#include "../formatters/TESSoulGem.hpp"
+#include "../inventory/SoulGemIndex.hpp"
+#include "../inventory/SoulGemTransaction.hpp"
+#include "../utilities/EnumArray.hpp"
+
+using namespace std::literals;
+
+namespace {
+    using Count = SoulGemInventory::Count;
+    using CapacityCounts = EnumArray<SoulGemCapacity, Count>;
+    using SoulSizeCounts = EnumArray<SoulSize, Count>;
+
+    /**
+     * @brief Returns the soul gem in the same group as the given one holding a
+     * soul of the given size.
+     */
+    [[nodiscard]] RE::TESSoulGem* getSoulGemInGroupAt_(
+        const SoulGemMap& soulGemMap,
+        RE::TESSoulGem* const soulGem,
+        const SoulGemClass& soulGemClass,
+        const SoulSize containedSoulSize)
+    {
+        const auto [begin, end] = soulGemMap.getSoulGemsWith(
+            soulGemClass.capacity,
+            soulGemClass.containedSoulSize);
+
+        for (auto it = begin; it != end; ++it) {
+            if (it.get() == soulGem) {
+                return it.group().at(containedSoulSize);
+            }
+        }
+
+        return nullptr;
+    }
+} // namespace
+
+std::optional<std::vector<SoulGemConversion>> planSoulConsolidation(
+    const SoulGemInventory& inventory,
+    const SoulGemMap& soulGemMap,
+    const bool allowPartiallyFillingSoulGems)
+{
+    // Soul gems are interchangeable with others of the same capacity and
+    // reusability, so count the souls and the soul gems separately.
+    SoulSizeCounts soulCounts{};
+    std::array<CapacityCounts, 2> freeCounts{};
+
+    inventory.forEachClass(
+        [&](const SoulGemClass& soulGemClass, const Count count) {
+            freeCounts[soulGemClass.isReusable][soulGemClass.capacity] += count;
+
+            if (soulGemClass.containedSoulSize != SoulSize::None) {
+                soulCounts[soulGemClass.containedSoulSize] += count;
+            }
+        });
+
+    // Counts indexed by [isReusable][capacity][containedSoulSize] once the
+    // souls are consolidated.
+    std::array<EnumArray<SoulGemCapacity, SoulSizeCounts>, 2> targetCounts{};
+
+    for (SoulSizeValue soulSize = SoulSize::Last; soulSize > SoulSize::None;
+         --soulSize) {
+        auto remainingCount = soulCounts[soulSize];
+        const auto capacities =
+            getSoulGemCapacitiesFor(soulSize, allowPartiallyFillingSoulGems);
+
+        for (const auto capacity : capacities) {
+            for (const bool isReusable : {true, false}) {
+                auto& freeCount = freeCounts[isReusable][capacity];
+                const auto placedCount = std::min(remainingCount, freeCount);
+
+                targetCounts[isReusable][capacity][soulSize] += placedCount;
+                freeCount -= placedCount;
+                remainingCount -= placedCount;
+            }
+        }
+
+        if (remainingCount > 0) {
+            LOG_WARN_FMT(
+                "Cannot place {} {} souls while consolidating souls."sv,
+                remainingCount,
+                soulSize);
+            return std::nullopt;
+        }
+    }
+
+    // Pair up the soul gems of classes with fewer soul gems than before with
+    // the classes that need more. Both add up to the same count for each
+    // capacity, since no soul gem is added or removed.
+    SoulGemInventory remainingInventory = inventory;
+    std::vector<SoulGemConversion> conversions;
+
+    for (const bool isReusable : {false, true}) {
+        for (SoulGemCapacityValue capacity = SoulGemCapacity::First;
+             capacity <= SoulGemCapacity::Last;
+             ++capacity) {
+            auto& capacityTargetCounts = targetCounts[isReusable][capacity];
+
+            capacityTargetCounts[SoulSize::None] =
+                freeCounts[isReusable][capacity];
+
+            std::vector<std::pair<SoulSize, Count>> surpluses;
+            std::vector<std::pair<SoulSize, Count>> shortfalls;
+
+            for (SoulSizeValue soulSize = SoulSize::First;
+                 soulSize <= SoulSize::Last;
+                 ++soulSize) {
+                const auto difference =
+                    capacityTargetCounts[soulSize] -
+                    inventory.count(capacity, soulSize, isReusable);
+
+                if (difference < 0) {
+                    surpluses.emplace_back(soulSize, -difference);
+                } else if (difference > 0) {
+                    shortfalls.emplace_back(soulSize, difference);
+                }
+            }
+
+            auto surplusIt = surpluses.begin();
+
+            for (auto& [targetSoulSize, shortfall] : shortfalls) {
+                while (shortfall > 0 && surplusIt != surpluses.end()) {
+                    auto& [sourceSoulSize, surplus] = *surplusIt;
+                    const SoulGemClass sourceClass{
+                        capacity,
+                        sourceSoulSize,
+                        isReusable};
+
+                    const auto soulGemToRemove =
+                        remainingInventory.findSoulGem(soulGemMap, sourceClass);
+                    const auto soulGemToAdd =
+                        soulGemToRemove != nullptr
+                            ? getSoulGemInGroupAt_(
+                                  soulGemMap,
+                                  soulGemToRemove,
+                                  sourceClass,
+                                  targetSoulSize)
+                            : nullptr;
+
+                    if (soulGemToAdd == nullptr) {
+                        LOG_WARN_FMT(
+                            "Cannot find {} soul gem to hold a {} soul while "
+                            "consolidating souls."sv,
+                            static_cast<SoulGemCapacity>(capacity),
+                            targetSoulSize);
+                        return std::nullopt;
+                    }
+
+                    const auto convertedCount = std::min(
+                        {shortfall,
+                         surplus,
+                         remainingInventory.countOf(soulGemToRemove)});
+
+                    remainingInventory.add(
+                        soulGemToRemove,
+                        sourceClass,
+                        -convertedCount);
+                    conversions.push_back(SoulGemConversion{
+                        soulGemToRemove,
+                        soulGemToAdd,
+                        convertedCount});
+
+                    shortfall -= convertedCount;
+                    surplus -= convertedCount;
+
+                    if (surplus == 0) {
+                        ++surplusIt;
+                    }
+                }
+            }
+        }
+    }
+
+    return conversions;
+}
+
+std::optional<std::vector<SoulGemConversion>>
+    planSoulConsolidation(RE::Actor* const actor)
+{
+    const auto& config = YASTMConfig::getInstance();
+
+    if (!config.isReady()) {
+        LOG_WARN("Configuration is not loaded. Skipping consolidation."sv);
+        return std::nullopt;
+    }
+
+    if (!config.getGlobalBool(BoolConfigKey::AllowSoulRelocation)) {
+        LOG_TRACE("Soul relocation is disabled. Skipping consolidation."sv);
+        return std::vector<SoulGemConversion>();
+    }
+
+    const auto inventory = SoulGemIndex::getInstance().get(actor);
+
+    return planSoulConsolidation(
+        *inventory,
+        getSoulGemMap(config),
+        config.getGlobalBool(BoolConfigKey::AllowPartiallyFillingSoulGems));
+}
+
+int consolidateSouls(RE::Actor* const actor)
+{
+    const auto conversions = planSoulConsolidation(actor);
+
+    if (!conversions.has_value()) {
+        return -1;
+    }
+
+    int changedSoulGemCount = 0;
+    SoulGemTransaction transaction;
+
+    for (const auto& [soulGemToRemove, soulGemToAdd, count] : *conversions) {
+        transaction.replace(soulGemToRemove, soulGemToAdd, count);
+        changedSoulGemCount += count;
+    }
+
+    if (transaction.empty()) {
+        return 0;
+    }
+
+    LOG_TRACE_FMT(
+        "Consolidating souls in {} soul gems."sv,
+        changedSoulGemCount);
+
+    const auto& config = YASTMConfig::getInstance();
+
+    if (!transaction.commit(
+            actor,
+            config.getGlobalBool(BoolConfigKey::PreserveOwnership))) {
+        return -1;
+    }
+
+    return changedSoulGemCount;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include "../inventory/SoulGemInventory.hpp"
+
+namespace RE {
+    class Actor;
+    class TESSoulGem;
+} // namespace RE
+
+class SoulGemMap;
+
+/**
+ * @brief Replaces count soul gems of one form with the soul gem of the same
+ * group holding a different soul.
+ */
+struct SoulGemConversion {
+    RE::TESSoulGem* soulGemToRemove;
+    RE::TESSoulGem* soulGemToAdd;
+    SoulGemInventory::Count count;
+};
+
+/**
+ * @brief Plans how to move the souls held in the inventory's soul gems so that
+ * as many of the largest soul gems as possible are left empty.
+ *
+ * Souls are placed largest first, each into the smallest soul gem that may
+ * hold it under the trap engine's rules (best-fit decreasing):
+ *
+ * - Black souls go into black soul gems first, then dual soul gems.
+ * - White souls go into soul gems of their own size. If
+ *   allowPartiallyFillingSoulGems is set, they may also go into larger soul
+ *   gems, dual soul gems last. Otherwise, only grand souls may go into dual
+ *   soul gems.
+ * - Reusable soul gems are filled before other soul gems of the same capacity.
+ *
+ * No soul is lost or shrunk.
+ *
+ * @returns std::nullopt if the souls can't all be placed under these rules.
+ */
+[[nodiscard]] std::optional<std::vector<SoulGemConversion>>
+    planSoulConsolidation(
+        const SoulGemInventory& inventory,
+        const SoulGemMap& soulGemMap,
+        bool allowPartiallyFillingSoulGems);
+
+/**
+ * @brief Plans consolidating the souls in the actor's soul gems (see
+ * planSoulConsolidation() above) with the loaded configuration.
+ *
+ * Moving souls between soul gems is soul relocation, so the plan is empty
+ * unless AllowSoulRelocation is enabled.
+ *
+ * @returns std::nullopt if the configuration is not loaded or the souls can't
+ * be consolidated.
+ */
+[[nodiscard]] std::optional<std::vector<SoulGemConversion>>
+    planSoulConsolidation(RE::Actor* actor);
+
+/**
+ * @brief Consolidates the souls in the actor's soul gems (see
+ * planSoulConsolidation()) and applies the changes to the inventory together.
+ *
+ * @returns The number of soul gems whose soul changes, or -1 if the souls
+ * can't be consolidated.
+ */
+int consolidateSouls(RE::Actor* actor);
@@ -0,0 +1,142 @@
+#include "enchanting.hpp"
+
+#include <tuple>
+
+#include <RE/A/Actor.h>
+#include <RE/E/Effect.h>
+#include <RE/E/EffectSetting.h>
+#include <RE/E/EnchantmentItem.h>
+#include <RE/T/TESSoulGem.h>
+
+#include "../global.hpp"
+#include "../config/configutilities.hpp"
+#include "../config/YASTMConfig.hpp"
+#include "../inventory/SoulGemIndex.hpp"
+
+using namespace std::literals;
+
+namespace {
+    /**
+     * @brief Returns how strongly the preference favors soul gems of the given
+     * class. Lower ranks are better.
+     */
+    int rankPreference_(
+        const SoulGemClass& soulGemClass,
+        const EnchantingSoulGemPreference preference)
+    {
+        switch (preference) {
+        case EnchantingSoulGemPreference::Reusable:
+            return soulGemClass.isReusable ? 0 : 1;
+        case EnchantingSoulGemPreference::ReusableThenDual: {
+            const bool isDual = soulGemClass.capacity == SoulGemCapacity::Dual;
+
+            if (soulGemClass.isReusable) {
+                return isDual ? 0 : 1;
+            }
+
+            // Keep the dual soul gems that enchanting would use up.
+            return isDual ? 3 : 2;
+        }
+        }
+
+        return 0;
+    }
+
+    /**
+     * @brief Ranks a soul gem class for enchanting an item. Lower ranks are
+     * better.
+     */
+    auto rankForEnchanting_(
+        const SoulGemClass& soulGemClass,
+        const SoulSize requiredSoulSize,
+        const EnchantingSoulGemPreference preference)
+    {
+        const auto soulValue = static_cast<int>(
+            toSoulLevelValue(soulGemClass.containedSoulSize));
+        const bool isStrongEnough =
+            soulValue >= static_cast<int>(toSoulLevelValue(requiredSoulSize));
+
+        return std::make_tuple(
+            !isStrongEnough,
+            // Smallest sufficient soul first, otherwise largest soul first.
+            isStrongEnough ? soulValue : -soulValue,
+            soulGemClass.containedSoulSize == SoulSize::Black,
+            rankPreference_(soulGemClass, preference),
+            soulGemClass.capacity);
+    }
+} // namespace
+
+SoulSize
+    getSoulSizeForMaxMagnitude(const RE::EnchantmentItem* const enchantment)
+{
+    using Flag = RE::EffectSetting::EffectSettingData::Flag;
+
+    // Weapon enchantments get their charge from the soul.
+    if (enchantment->GetCastingType() !=
+        RE::MagicSystem::CastingType::kConstantEffect) {
+        return SoulSize::Grand;
+    }
+
+    for (const auto effect : enchantment->effects) {
+        if (effect != nullptr && effect->baseEffect != nullptr &&
+            effect->baseEffect->data.flags.none(Flag::kNoMagnitude)) {
+            return SoulSize::Grand;
+        }
+    }
+
+    return SoulSize::Petty;
+}
+
+std::optional<SoulGemClass> selectEnchantingSoulGemClass(
+    const SoulGemInventory& inventory,
+    const SoulSize requiredSoulSize,
+    const EnchantingSoulGemPreference preference)
+{
+    std::optional<SoulGemClass> bestClass;
+
+    inventory.forEachClass([&](const SoulGemClass& soulGemClass, auto) {
+        if (soulGemClass.containedSoulSize == SoulSize::None) {
+            return;
+        }
+
+        if (!bestClass.has_value() ||
+            rankForEnchanting_(soulGemClass, requiredSoulSize, preference) <
+                rankForEnchanting_(*bestClass, requiredSoulSize, preference)) {
+            bestClass = soulGemClass;
+        }
+    });
+
+    return bestClass;
+}
+
+RE::TESSoulGem* findEnchantingSoulGem(
+    RE::Actor* const actor,
+    const RE::EnchantmentItem* const enchantment)
+{
+    const auto& config = YASTMConfig::getInstance();
+
+    if (!config.isReady()) {
+        LOG_WARN("Configuration is not loaded. Skipping soul gem lookup."sv);
+        return nullptr;
+    }
+
+    const auto requiredSoulSize = getSoulSizeForMaxMagnitude(enchantment);
+    const auto preference =
+        config.getGlobalEnum<EnumConfigKey::EnchantingSoulGemPreference>();
+
+    LOG_TRACE_FMT(
+        "Looking up soul gem for enchanting (required soul: {}, preference: "
+        "{})"sv,
+        requiredSoulSize,
+        preference);
+
+    const auto inventory = SoulGemIndex::getInstance().get(actor);
+    const auto soulGemClass =
+        selectEnchantingSoulGemClass(*inventory, requiredSoulSize, preference);
+
+    if (!soulGemClass.has_value()) {
+        return nullptr;
+    }
+
+    return inventory->findSoulGem(getSoulGemMap(config), *soulGemClass);
+}
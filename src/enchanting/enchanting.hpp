@@ -0,0 +1,52 @@
+#pragma once
+
+#include <optional>
+
+#include "../config/ConfigKey/EnumConfigKey.hpp"
+#include "../inventory/SoulGemInventory.hpp"
+
+namespace RE {
+    class Actor;
+    class EnchantmentItem;
+    class TESSoulGem;
+} // namespace RE
+
+/**
+ * @brief Returns the smallest soul that enchants an item with the given
+ * enchantment at full strength.
+ *
+ * The soul sets the magnitude of apparel enchantments and the charge of weapon
+ * enchantments, both of which peak with a grand soul. Only apparel
+ * enchantments whose effects have no magnitude are as strong with any soul.
+ */
+[[nodiscard]] SoulSize
+    getSoulSizeForMaxMagnitude(const RE::EnchantmentItem* enchantment);
+
+/**
+ * @brief Picks the class of filled soul gem to enchant an item with.
+ *
+ * This picks the smallest soul at least as large as requiredSoulSize, or the
+ * largest soul if there is none. Black souls are only picked if there is no
+ * white soul as strong. Ties are broken by the preference, then by picking
+ * smaller soul gems.
+ *
+ * This only looks at the counts of each class, so it takes the same time
+ * regardless of the inventory size.
+ *
+ * @returns std::nullopt if the inventory has no filled soul gems.
+ */
+[[nodiscard]] std::optional<SoulGemClass> selectEnchantingSoulGemClass(
+    const SoulGemInventory& inventory,
+    SoulSize requiredSoulSize,
+    EnchantingSoulGemPreference preference);
+
+/**
+ * @brief Returns the filled soul gem owned by the actor to enchant an item
+ * with the given enchantment with (see selectEnchantingSoulGemClass()), using
+ * the configured preference.
+ *
+ * @returns nullptr if the actor owns no filled soul gems.
+ */
+[[nodiscard]] RE::TESSoulGem* findEnchantingSoulGem(
+    RE::Actor* actor,
+    const RE::EnchantmentItem* enchantment);
@@ -1,385 +1,1175 @@
-#include "FSUtils.hpp"
-
-#include <functional>
-#include <sstream>
-
-#include <RE/V/VirtualMachine.h>
-
-#include "global.hpp"
-#include "internal/ConfigManager.hpp"
-#include "../utilities/PapyrusFunctionRegistry.hpp"
-#include "../utilities/printerror.hpp"
-
-using namespace std::literals;
-using RE::BSScript::Internal::VirtualMachine;
-
-namespace {
-    bool FileExists(
-        VirtualMachine* const vm,
-        const RE::VMStackID stackId,
-        RE::StaticFunctionTag*,
-        const RE::BSFixedString path)
-    {
-        std::filesystem::path filePath("Data");
-        filePath /= path.c_str();
-
-        try {
-            return std::filesystem::exists(filePath);
-        } catch (const std::exception& error) {
-            std::stringstream stream;
-
-            printErrorToStream(error, stream);
-            vm->TraceStack(
-                stream.str().c_str(),
-                stackId,
-                RE::BSScript::ErrorLogger::Severity::kInfo);
-        }
-
-        return false;
-    }
-
-    bool RemoveFile(
-        RE::BSScript::Internal::VirtualMachine* const vm,
-        const RE::VMStackID stackId,
-        RE::StaticFunctionTag*,
-        const RE::BSFixedString path)
-    {
-        std::filesystem::path filePath("Data");
-        filePath /= path.c_str();
-
-        try {
-            return std::filesystem::remove(filePath);
-        } catch (const std::exception& error) {
-            std::stringstream stream;
-
-            printErrorToStream(error, stream);
-            vm->TraceStack(
-                stream.str().c_str(),
-                stackId,
-                RE::BSScript::ErrorLogger::Severity::kInfo);
-        }
-
-        return false;
-    }
-
-    ConfigManager::HandleType CreateConfig(
-        RE::BSScript::Internal::VirtualMachine* const vm,
-        const RE::VMStackID stackId,
-        RE::StaticFunctionTag*)
-    {
-        try {
-            return ConfigManager::getInstance().createConfig();
-        } catch (const std::exception& error) {
-            std::stringstream stream;
-
-            printErrorToStream(error, stream);
-            vm->TraceStack(
-                stream.str().c_str(),
-                stackId,
-                RE::BSScript::ErrorLogger::Severity::kInfo);
-        }
-
-        return 0;
-    }
-
-    ConfigManager::HandleType OpenConfig(
-        RE::BSScript::Internal::VirtualMachine* const vm,
-        const RE::VMStackID stackId,
-        RE::StaticFunctionTag*,
-        const RE::BSFixedString path)
-    {
-        if (path.length() <= 0) {
-            vm->TraceStack("File path is empty", stackId);
-            return 0;
-        }
-
-        std::filesystem::path filePath("Data");
-        filePath /= path.c_str();
-
-        try {
-            return ConfigManager::getInstance().openConfig(filePath);
-        } catch (const std::exception& error) {
-            std::stringstream stream;
-
-            printErrorToStream(error, stream);
-            vm->TraceStack(
-                stream.str().c_str(),
-                stackId,
-                RE::BSScript::ErrorLogger::Severity::kInfo);
-        }
-
-        return 0;
-    }
-
-    bool SaveConfig(
-        RE::BSScript::Internal::VirtualMachine* const vm,
-        const RE::VMStackID stackId,
-        RE::StaticFunctionTag*,
-        const ConfigManager::HandleType handle,
-        const RE::BSFixedString path)
-    {
-        std::filesystem::path filePath("Data");
-        filePath /= path.c_str();
-
-        try {
-            ConfigManager::getInstance().saveConfig(handle, filePath);
-
-            return true;
-        } catch (const std::exception& error) {
-            std::stringstream stream;
-
-            printErrorToStream(error, stream);
-            vm->TraceStack(
-                stream.str().c_str(),
-                stackId,
-                RE::BSScript::ErrorLogger::Severity::kInfo);
-        }
-
-        return false;
-    }
-
-    void CloseConfig(
-        RE::BSScript::Internal::VirtualMachine* const vm,
-        const RE::VMStackID stackId,
-        RE::StaticFunctionTag*,
-        const ConfigManager::HandleType handle)
-    {
-        try {
-            ConfigManager::getInstance().closeConfig(handle);
-        } catch (const std::exception& error) {
-            std::stringstream stream;
-
-            printErrorToStream(error, stream);
-            vm->TraceStack(
-                stream.str().c_str(),
-                stackId,
-                RE::BSScript::ErrorLogger::Severity::kInfo);
-        }
-    }
-
-    bool HasEntry(
-        RE::BSScript::Internal::VirtualMachine* const vm,
-        const RE::VMStackID stackId,
-        RE::StaticFunctionTag*,
-        const ConfigManager::HandleType handle,
-        const RE::BSFixedString key)
-    {
-        if (key.length() <= 0) {
-            vm->TraceStack("Key is empty", stackId);
-            return false;
-        }
-
-        try {
-            auto maybeConfig = ConfigManager::getInstance().getConfig(handle);
-
-            if (maybeConfig.has_value()) {
-                auto& config = maybeConfig.value().get();
-
-                return config.has(key);
-            }
-        } catch (const std::exception& error) {
-            std::stringstream stream;
-
-            printErrorToStream(error, stream);
-            vm->TraceStack(
-                stream.str().c_str(),
-                stackId,
-                RE::BSScript::ErrorLogger::Severity::kInfo);
-        }
-
-        return false;
-    }
-
-    template <typename T>
-    bool SetValue(
-        RE::BSScript::Internal::VirtualMachine* const vm,
-        const RE::VMStackID stackId,
-        RE::StaticFunctionTag*,
-        const ConfigManager::HandleType handle,
-        const RE::BSFixedString key,
-        const T value)
-    {
-        if (key.length() <= 0) {
-            vm->TraceStack("Key is empty", stackId);
-            return false;
-        }
-
-        try {
-            auto maybeConfig = ConfigManager::getInstance().getConfig(handle);
-
-            if (maybeConfig.has_value()) {
-                auto& config = maybeConfig.value().get();
-                config.set(key, value);
-
-                return true;
-            }
-        } catch (const std::exception& error) {
-            std::stringstream stream;
-
-            printErrorToStream(error, stream);
-            vm->TraceStack(
-                stream.str().c_str(),
-                stackId,
-                RE::BSScript::ErrorLogger::Severity::kInfo);
-        }
-
-        return false;
-    }
-
-    template <typename T>
-    T GetValue(
-        RE::BSScript::Internal::VirtualMachine* const vm,
-        const RE::VMStackID stackId,
-        RE::StaticFunctionTag*,
-        const ConfigManager::HandleType handle,
-        const RE::BSFixedString key,
-        const T defaultValue)
-    {
-        if (key.length() <= 0) {
-            vm->TraceStack("Key is empty", stackId);
-            return defaultValue;
-        }
-
-        try {
-            auto maybeConfig = ConfigManager::getInstance().getConfig(handle);
-
-            if (maybeConfig.has_value()) {
-                auto& config = maybeConfig.value().get();
-                return config.get(key, defaultValue);
-            }
-        } catch (const std::exception& error) {
-            std::stringstream stream;
-
-            printErrorToStream(error, stream);
-            vm->TraceStack(
-                stream.str().c_str(),
-                stackId,
-                RE::BSScript::ErrorLogger::Severity::kInfo);
-        }
-
-        return defaultValue;
-    }
-
-    int GetConfigCount(
-        RE::BSScript::Internal::VirtualMachine* const vm,
-        const RE::VMStackID stackId,
-        RE::StaticFunctionTag*)
-    {
-        try {
-            // This truncates the value since std::size_t is defined (in this
-            // writing's context) as 'unsigned long long' while we're return an int.
-            //
-            // However, this is unavoidable since Papyrus has no support for an
-            // integer of this size and, short of an actual bug causing a bunch of
-            // open configurations, should never happen anyway.
-            return static_cast<int>(ConfigManager::getInstance().size());
-        } catch (const std::exception& error) {
-            std::stringstream stream;
-
-            printErrorToStream(error, stream);
-            vm->TraceStack(
-                stream.str().c_str(),
-                stackId,
-                RE::BSScript::ErrorLogger::Severity::kInfo);
-        }
-
-        return 0;
-    }
-
-    ConfigManager::HandleType GetLargestHandle(
-        RE::BSScript::Internal::VirtualMachine* const vm,
-        const RE::VMStackID stackId,
-        RE::StaticFunctionTag*)
-    {
-        try {
-            return ConfigManager::getInstance().getLargestHandle();
-        } catch (const std::exception& error) {
-            std::stringstream stream;
-
-            printErrorToStream(error, stream);
-            vm->TraceStack(
-                stream.str().c_str(),
-                stackId,
-                RE::BSScript::ErrorLogger::Severity::kInfo);
-        }
-
-        return 0;
-    }
-
-    ConfigManager::HandleType GetNextHandle(
-        RE::BSScript::Internal::VirtualMachine* const vm,
-        const RE::VMStackID stackId,
-        RE::StaticFunctionTag*)
-    {
-        try {
-            return ConfigManager::getInstance().getNextHandle();
-        } catch (const std::exception& error) {
-            std::stringstream stream;
-
-            printErrorToStream(error, stream);
-            vm->TraceStack(
-                stream.str().c_str(),
-                stackId,
-                RE::BSScript::ErrorLogger::Severity::kInfo);
-        }
-
-        return 0;
-    }
-
-    void CloseAllConfigs(
-        RE::BSScript::Internal::VirtualMachine* const vm,
-        const RE::VMStackID stackId,
-        RE::StaticFunctionTag*)
-    {
-        try {
-            ConfigManager::getInstance().closeAllConfigs();
-        } catch (const std::exception& error) {
-            std::stringstream stream;
-
-            printErrorToStream(error, stream);
-            vm->TraceStack(
-                stream.str().c_str(),
-                stackId,
-                RE::BSScript::ErrorLogger::Severity::kInfo);
-        }
-    }
-
-    bool registerPapyrusFunctions_(VirtualMachine* const vm)
-    {
-        if (vm == nullptr) {
-            LOG_ERROR("Couldn't get VM State"sv);
-            return false;
-        }
-
-        PapyrusFunctionRegistry registry("YASTMFSUtils", vm);
-
-        // General file system functions
-        registry.registerFunction("FileExists", FileExists);
-        registry.registerFunction("RemoveFile", RemoveFile);
-
-        // Functions handling configuration files.
-        registry.registerFunction("CreateConfig", CreateConfig);
-        registry.registerFunction("OpenConfig", OpenConfig);
-        registry.registerFunction("SaveConfig", SaveConfig);
-        registry.registerFunction("CloseConfig", CloseConfig);
-
-        registry.registerFunction("HasEntry", HasEntry);
-        registry.registerFunction("GetInt", GetValue<int>);
-        registry.registerFunction("GetFloat", GetValue<float>);
-        registry.registerFunction("SetInt", SetValue<int>);
-        registry.registerFunction("SetFloat", SetValue<float>);
-
-        // Functions for debugging purposes.
-        registry.registerFunction("GetConfigCount", GetConfigCount);
-        registry.registerFunction("GetLargestHandle", GetLargestHandle);
-        registry.registerFunction("GetNextHandle", GetNextHandle);
-        registry.registerFunction("CloseAllConfigs", CloseAllConfigs);
-
-        return true;
-    }
-} // namespace
-
-bool registerFSUtils(const SKSE::PapyrusInterface* const papyrus)
-{
-    return papyrus->Register(registerPapyrusFunctions_);
-}
+#include "FSUtils.hpp"
+
+#include <chrono>
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <RE/V/VirtualMachine.h>
+
+#include "global.hpp"
+#include "internal/ConfigManager.hpp"
+#include "internal/ConfigPathRegistry.hpp"
+#include "internal/ConfigWriter.hpp"
+#include "internal/DirectoryIndex.hpp"
+#include "internal/IoExecutor.hpp"
+#include "../utilities/PapyrusFunctionRegistry.hpp"
+#include "../utilities/printerror.hpp"
+
+using namespace std::literals;
+using RE::BSScript::Internal::VirtualMachine;
+
+namespace {
+    /**
+     * @brief Returns the name of the script that called the native function
+     * running on the given stack, or an empty string if it can't be found.
+     */
+    std::string getCallingScriptName_(
+        VirtualMachine* const vm,
+        const RE::VMStackID stackId)
+    {
+        RE::BSSpinLockGuard lock(vm->runningStacksLock);
+
+        const auto it = vm->allRunningStacks.find(stackId);
+
+        if (it == vm->allRunningStacks.end() || it->second == nullptr) {
+            return "";
+        }
+
+        // Skip the native function's own frame.
+        for (auto frame = it->second->top; frame != nullptr;
+             frame = frame->previousFrame) {
+            const auto& function = frame->owningFunction;
+
+            if (function != nullptr && !function->GetIsNative()) {
+                return function->GetObjectTypeName().c_str();
+            }
+        }
+
+        return "";
+    }
+
+    bool FileExists(
+        VirtualMachine* const vm,
+        const RE::VMStackID stackId,
+        RE::StaticFunctionTag*,
+        const RE::BSFixedString path)
+    {
+        std::filesystem::path filePath("Data");
+        filePath /= path.c_str();
+
+        try {
+            // A pending background write may be about to create the file.
+            ConfigWriter::getInstance().flush(filePath);
+
+            return DirectoryIndex::getInstance().exists(filePath);
+        } catch (const std::exception& error) {
+            std::stringstream stream;
+
+            printErrorToStream(error, stream);
+            vm->TraceStack(
+                stream.str().c_str(),
+                stackId,
+                RE::BSScript::ErrorLogger::Severity::kInfo);
+        }
+
+        return false;
+    }
+
+    bool RemoveFile(
+        RE::BSScript::Internal::VirtualMachine* const vm,
+        const RE::VMStackID stackId,
+        RE::StaticFunctionTag*,
+        const RE::BSFixedString path)
+    {
+        std::filesystem::path filePath("Data");
+        filePath /= path.c_str();
+
+        try {
+            // Otherwise a pending background write could recreate the file.
+            ConfigWriter::getInstance().flush(filePath);
+
+            const auto isRemoved = std::filesystem::remove(filePath);
+            DirectoryIndex::getInstance().invalidate(filePath.parent_path());
+
+            return isRemoved;
+        } catch (const std::exception& error) {
+            std::stringstream stream;
+
+            printErrorToStream(error, stream);
+            vm->TraceStack(
+                stream.str().c_str(),
+                stackId,
+                RE::BSScript::ErrorLogger::Severity::kInfo);
+        }
+
+        return false;
+    }
+
+    // Returns int instead of bool entries since std::vector<bool> doesn't store
+    // actual bools for the VM to pack into an array.
+    std::vector<int> FilesExist(
+        VirtualMachine* const vm,
+        const RE::VMStackID stackId,
+        RE::StaticFunctionTag*,
+        const std::vector<RE::BSFixedString> paths)
+    {
+        std::vector<int> results(paths.size(), 0);
+
+        try {
+            auto& directoryIndex = DirectoryIndex::getInstance();
+
+            for (std::size_t i = 0; i < paths.size(); ++i) {
+                std::filesystem::path filePath("Data");
+                filePath /= paths[i].c_str();
+
+                ConfigWriter::getInstance().flush(filePath);
+                results[i] = directoryIndex.exists(filePath);
+            }
+        } catch (const std::exception& error) {
+            std::stringstream stream;
+
+            printErrorToStream(error, stream);
+            vm->TraceStack(
+                stream.str().c_str(),
+                stackId,
+                RE::BSScript::ErrorLogger::Severity::kInfo);
+        }
+
+        return results;
+    }
+
+    std::vector<std::string> ListFiles(
+        VirtualMachine* const vm,
+        const RE::VMStackID stackId,
+        RE::StaticFunctionTag*,
+        const RE::BSFixedString pattern)
+    {
+        const std::string_view patternView(pattern.c_str(), pattern.length());
+        const auto separatorPosition = patternView.find_last_of("/\\");
+        // Keep the directory part as given so that the results can be passed
+        // straight to the other functions.
+        const auto directoryPart =
+            separatorPosition != std::string_view::npos
+                ? patternView.substr(0, separatorPosition + 1)
+                : std::string_view();
+        const auto namePattern = patternView.substr(directoryPart.size());
+
+        if (namePattern.empty()) {
+            vm->TraceStack("File name pattern is empty", stackId);
+            return {};
+        }
+
+        if (directoryPart.find_first_of("*?") != std::string_view::npos) {
+            vm->TraceStack(
+                "Wildcards are only supported in the file name",
+                stackId);
+            return {};
+        }
+
+        std::vector<std::string> results;
+
+        try {
+            std::filesystem::path directoryPath("Data");
+            directoryPath /= directoryPart;
+
+            results = DirectoryIndex::getInstance().listFiles(
+                directoryPath,
+                namePattern);
+
+            for (auto& name : results) { name.insert(0, directoryPart); }
+        } catch (const std::exception& error) {
+            std::stringstream stream;
+
+            printErrorToStream(error, stream);
+            vm->TraceStack(
+                stream.str().c_str(),
+                stackId,
+                RE::BSScript::ErrorLogger::Severity::kInfo);
+        }
+
+        return results;
+    }
+
+    ConfigManager::HandleType CreateConfig(
+        RE::BSScript::Internal::VirtualMachine* const vm,
+        const RE::VMStackID stackId,
+        RE::StaticFunctionTag*)
+    {
+        try {
+            return ConfigManager::getInstance().createConfig(
+                getCallingScriptName_(vm, stackId));
+        } catch (const std::exception& error) {
+            std::stringstream stream;
+
+            printErrorToStream(error, stream);
+            vm->TraceStack(
+                stream.str().c_str(),
+                stackId,
+                RE::BSScript::ErrorLogger::Severity::kInfo);
+        }
+
+        return 0;
+    }
+
+    ConfigManager::HandleType OpenConfig(
+        RE::BSScript::Internal::VirtualMachine* const vm,
+        const RE::VMStackID stackId,
+        RE::StaticFunctionTag*,
+        const RE::BSFixedString path)
+    {
+        if (path.length() <= 0) {
+            vm->TraceStack("File path is empty", stackId);
+            return 0;
+        }
+
+        std::filesystem::path filePath("Data");
+        filePath /= path.c_str();
+
+        try {
+            return ConfigManager::getInstance().openConfig(
+                filePath,
+                getCallingScriptName_(vm, stackId));
+        } catch (const std::exception& error) {
+            std::stringstream stream;
+
+            printErrorToStream(error, stream);
+            vm->TraceStack(
+                stream.str().c_str(),
+                stackId,
+                RE::BSScript::ErrorLogger::Severity::kInfo);
+        }
+
+        return 0;
+    }
+
+    bool SaveConfig(
+        RE::BSScript::Internal::VirtualMachine* const vm,
+        const RE::VMStackID stackId,
+        RE::StaticFunctionTag*,
+        const ConfigManager::HandleType handle,
+        const RE::BSFixedString path)
+    {
+        std::filesystem::path filePath("Data");
+        filePath /= path.c_str();
+
+        try {
+            // Wait for the write, since there's no point where pending writes
+            // can be finished when the game exits. SaveConfigAsync() waits
+            // without blocking other scripts.
+            bool isWritten = false;
+            const bool isQueued = ConfigManager::getInstance().saveConfig(
+                handle,
+                filePath,
+                [&isWritten](const bool result) { isWritten = result; });
+
+            if (isQueued) {
+                ConfigWriter::getInstance().flush(filePath);
+            }
+
+            return isQueued && isWritten;
+        } catch (const std::exception& error) {
+            std::stringstream stream;
+
+            printErrorToStream(error, stream);
+            vm->TraceStack(
+                stream.str().c_str(),
+                stackId,
+                RE::BSScript::ErrorLogger::Severity::kInfo);
+        }
+
+        return false;
+    }
+
+    void CloseConfig(
+        RE::BSScript::Internal::VirtualMachine* const vm,
+        const RE::VMStackID stackId,
+        RE::StaticFunctionTag*,
+        const ConfigManager::HandleType handle)
+    {
+        try {
+            ConfigManager::getInstance().closeConfig(handle);
+        } catch (const std::exception& error) {
+            std::stringstream stream;
+
+            printErrorToStream(error, stream);
+            vm->TraceStack(
+                stream.str().c_str(),
+                stackId,
+                RE::BSScript::ErrorLogger::Severity::kInfo);
+        }
+    }
+
+    bool ConvertConfig(
+        RE::BSScript::Internal::VirtualMachine* const vm,
+        const RE::VMStackID stackId,
+        RE::StaticFunctionTag*,
+        const RE::BSFixedString sourcePath,
+        const RE::BSFixedString destinationPath)
+    {
+        if (sourcePath.length() <= 0 || destinationPath.length() <= 0) {
+            vm->TraceStack("File path is empty", stackId);
+            return false;
+        }
+
+        std::filesystem::path sourceFilePath("Data");
+        sourceFilePath /= sourcePath.c_str();
+
+        std::filesystem::path destinationFilePath("Data");
+        destinationFilePath /= destinationPath.c_str();
+
+        try {
+            bool isWritten = false;
+            const auto skippedCount =
+                ConfigManager::getInstance().convertConfig(
+                    sourceFilePath,
+                    destinationFilePath,
+                    [&isWritten](const bool result) { isWritten = result; });
+
+            // Like SaveConfig(), don't leave the write pending.
+            ConfigWriter::getInstance().flush(destinationFilePath);
+
+            if (skippedCount > 0) {
+                vm->TraceStack(
+                    fmt::format(
+                        FMT_STRING("Skipped {} entries that can't be stored "
+                                   "in the destination format"sv),
+                        skippedCount)
+                        .c_str(),
+                    stackId,
+                    RE::BSScript::ErrorLogger::Severity::kWarning);
+            }
+
+            return isWritten;
+        } catch (const std::exception& error) {
+            std::stringstream stream;
+
+            printErrorToStream(error, stream);
+            vm->TraceStack(
+                stream.str().c_str(),
+                stackId,
+                RE::BSScript::ErrorLogger::Severity::kInfo);
+        }
+
+        return false;
+    }
+
+    bool HasEntry(
+        RE::BSScript::Internal::VirtualMachine* const vm,
+        const RE::VMStackID stackId,
+        RE::StaticFunctionTag*,
+        const ConfigManager::HandleType handle,
+        const RE::BSFixedString key)
+    {
+        if (key.length() <= 0) {
+            vm->TraceStack("Key is empty", stackId);
+            return false;
+        }
+
+        try {
+            const auto config = ConfigManager::getInstance().getConfig(handle);
+
+            if (config != nullptr) {
+                return config->has(key);
+            }
+        } catch (const std::exception& error) {
+            std::stringstream stream;
+
+            printErrorToStream(error, stream);
+            vm->TraceStack(
+                stream.str().c_str(),
+                stackId,
+                RE::BSScript::ErrorLogger::Severity::kInfo);
+        }
+
+        return false;
+    }
+
+    template <typename T>
+    bool SetValue(
+        RE::BSScript::Internal::VirtualMachine* const vm,
+        const RE::VMStackID stackId,
+        RE::StaticFunctionTag*,
+        const ConfigManager::HandleType handle,
+        const RE::BSFixedString key,
+        const T value)
+    {
+        if (key.length() <= 0) {
+            vm->TraceStack("Key is empty", stackId);
+            return false;
+        }
+
+        try {
+            const auto config = ConfigManager::getInstance().getConfig(handle);
+
+            if (config != nullptr) {
+                config->set(key, value);
+
+                return true;
+            }
+        } catch (const std::exception& error) {
+            std::stringstream stream;
+
+            printErrorToStream(error, stream);
+            vm->TraceStack(
+                stream.str().c_str(),
+                stackId,
+                RE::BSScript::ErrorLogger::Severity::kInfo);
+        }
+
+        return false;
+    }
+
+    template <typename T>
+    T GetValue(
+        RE::BSScript::Internal::VirtualMachine* const vm,
+        const RE::VMStackID stackId,
+        RE::StaticFunctionTag*,
+        const ConfigManager::HandleType handle,
+        const RE::BSFixedString key,
+        const T defaultValue)
+    {
+        if (key.length() <= 0) {
+            vm->TraceStack("Key is empty", stackId);
+            return defaultValue;
+        }
+
+        try {
+            const auto config = ConfigManager::getInstance().getConfig(handle);
+
+            if (config != nullptr) {
+                return config->get(key, defaultValue);
+            }
+        } catch (const std::exception& error) {
+            std::stringstream stream;
+
+            printErrorToStream(error, stream);
+            vm->TraceStack(
+                stream.str().c_str(),
+                stackId,
+                RE::BSScript::ErrorLogger::Severity::kInfo);
+        }
+
+        return defaultValue;
+    }
+
+    ConfigPathRegistry::IdType CompilePath(
+        RE::BSScript::Internal::VirtualMachine* const vm,
+        const RE::VMStackID stackId,
+        RE::StaticFunctionTag*,
+        const RE::BSFixedString path)
+    {
+        try {
+            return ConfigPathRegistry::getInstance().compile(path);
+        } catch (const std::exception& error) {
+            std::stringstream stream;
+
+            printErrorToStream(error, stream);
+            vm->TraceStack(
+                stream.str().c_str(),
+                stackId,
+                RE::BSScript::ErrorLogger::Severity::kInfo);
+        }
+
+        return 0;
+    }
+
+    /**
+     * @brief Returns the compiled path with the given ID. Reports an invalid ID
+     * to the Papyrus log.
+     */
+    const ConfigPath* getCompiledPath_(
+        VirtualMachine* const vm,
+        const RE::VMStackID stackId,
+        const ConfigPathRegistry::IdType pathId)
+    {
+        const auto path = ConfigPathRegistry::getInstance().get(pathId);
+
+        if (path == nullptr) {
+            vm->TraceStack(
+                fmt::format(FMT_STRING("Invalid path ID: {}"sv), pathId)
+                    .c_str(),
+                stackId);
+        }
+
+        return path;
+    }
+
+    bool HasEntryAt(
+        RE::BSScript::Internal::VirtualMachine* const vm,
+        const RE::VMStackID stackId,
+        RE::StaticFunctionTag*,
+        const ConfigManager::HandleType handle,
+        const ConfigPathRegistry::IdType pathId)
+    {
+        const auto path = getCompiledPath_(vm, stackId, pathId);
+
+        if (path == nullptr) {
+            return false;
+        }
+
+        try {
+            const auto config = ConfigManager::getInstance().getConfig(handle);
+
+            if (config != nullptr) {
+                return config->has(*path);
+            }
+        } catch (const std::exception& error) {
+            std::stringstream stream;
+
+            printErrorToStream(error, stream);
+            vm->TraceStack(
+                stream.str().c_str(),
+                stackId,
+                RE::BSScript::ErrorLogger::Severity::kInfo);
+        }
+
+        return false;
+    }
+
+    template <typename T>
+    bool SetValueAt(
+        RE::BSScript::Internal::VirtualMachine* const vm,
+        const RE::VMStackID stackId,
+        RE::StaticFunctionTag*,
+        const ConfigManager::HandleType handle,
+        const ConfigPathRegistry::IdType pathId,
+        const T value)
+    {
+        const auto path = getCompiledPath_(vm, stackId, pathId);
+
+        if (path == nullptr) {
+            return false;
+        }
+
+        try {
+            const auto config = ConfigManager::getInstance().getConfig(handle);
+
+            if (config != nullptr) {
+                config->set(*path, value);
+
+                return true;
+            }
+        } catch (const std::exception& error) {
+            std::stringstream stream;
+
+            printErrorToStream(error, stream);
+            vm->TraceStack(
+                stream.str().c_str(),
+                stackId,
+                RE::BSScript::ErrorLogger::Severity::kInfo);
+        }
+
+        return false;
+    }
+
+    template <typename T>
+    T GetValueAt(
+        RE::BSScript::Internal::VirtualMachine* const vm,
+        const RE::VMStackID stackId,
+        RE::StaticFunctionTag*,
+        const ConfigManager::HandleType handle,
+        const ConfigPathRegistry::IdType pathId,
+        const T defaultValue)
+    {
+        const auto path = getCompiledPath_(vm, stackId, pathId);
+
+        if (path == nullptr) {
+            return defaultValue;
+        }
+
+        try {
+            const auto config = ConfigManager::getInstance().getConfig(handle);
+
+            if (config != nullptr) {
+                return config->get(*path, defaultValue);
+            }
+        } catch (const std::exception& error) {
+            std::stringstream stream;
+
+            printErrorToStream(error, stream);
+            vm->TraceStack(
+                stream.str().c_str(),
+                stackId,
+                RE::BSScript::ErrorLogger::Severity::kInfo);
+        }
+
+        return defaultValue;
+    }
+
+    /**
+     * @brief Checks that no key is empty and that there is one value for every
+     * key. Reports the problem to the Papyrus log if not.
+     */
+    bool validateBatch_(
+        VirtualMachine* const vm,
+        const RE::VMStackID stackId,
+        const std::vector<RE::BSFixedString>& keys,
+        const std::size_t valueCount)
+    {
+        if (keys.size() != valueCount) {
+            vm->TraceStack(
+                fmt::format(
+                    FMT_STRING("Got {} keys but {} values"sv),
+                    keys.size(),
+                    valueCount)
+                    .c_str(),
+                stackId);
+            return false;
+        }
+
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            if (keys[i].length() <= 0) {
+                vm->TraceStack(
+                    fmt::format(FMT_STRING("Key at index {} is empty"sv), i)
+                        .c_str(),
+                    stackId);
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Returns int instead of bool entries since std::vector<bool> doesn't store
+    // actual bools for the VM to pack into an array.
+    std::vector<int> HasEntries(
+        RE::BSScript::Internal::VirtualMachine* const vm,
+        const RE::VMStackID stackId,
+        RE::StaticFunctionTag*,
+        const ConfigManager::HandleType handle,
+        const std::vector<RE::BSFixedString> keys)
+    {
+        if (!validateBatch_(vm, stackId, keys, keys.size())) {
+            return std::vector<int>(keys.size(), 0);
+        }
+
+        try {
+            const auto config = ConfigManager::getInstance().getConfig(handle);
+
+            if (config != nullptr) {
+                return config->hasAll(keys);
+            }
+        } catch (const std::exception& error) {
+            std::stringstream stream;
+
+            printErrorToStream(error, stream);
+            vm->TraceStack(
+                stream.str().c_str(),
+                stackId,
+                RE::BSScript::ErrorLogger::Severity::kInfo);
+        }
+
+        return std::vector<int>(keys.size(), 0);
+    }
+
+    template <typename T>
+    bool SetValues(
+        RE::BSScript::Internal::VirtualMachine* const vm,
+        const RE::VMStackID stackId,
+        RE::StaticFunctionTag*,
+        const ConfigManager::HandleType handle,
+        const std::vector<RE::BSFixedString> keys,
+        const std::vector<T> values)
+    {
+        if (!validateBatch_(vm, stackId, keys, values.size())) {
+            return false;
+        }
+
+        try {
+            const auto config = ConfigManager::getInstance().getConfig(handle);
+
+            if (config != nullptr) {
+                config->setAll(keys, values);
+
+                return true;
+            }
+        } catch (const std::exception& error) {
+            std::stringstream stream;
+
+            printErrorToStream(error, stream);
+            vm->TraceStack(
+                stream.str().c_str(),
+                stackId,
+                RE::BSScript::ErrorLogger::Severity::kInfo);
+        }
+
+        return false;
+    }
+
+    bool SetMixedValues(
+        RE::BSScript::Internal::VirtualMachine* const vm,
+        const RE::VMStackID stackId,
+        RE::StaticFunctionTag*,
+        const ConfigManager::HandleType handle,
+        const std::vector<RE::BSFixedString> intKeys,
+        const std::vector<int> intValues,
+        const std::vector<RE::BSFixedString> floatKeys,
+        const std::vector<float> floatValues)
+    {
+        if (!validateBatch_(vm, stackId, intKeys, intValues.size()) ||
+            !validateBatch_(vm, stackId, floatKeys, floatValues.size())) {
+            return false;
+        }
+
+        try {
+            const auto config = ConfigManager::getInstance().getConfig(handle);
+
+            if (config != nullptr) {
+                config->setAll(intKeys, intValues, floatKeys, floatValues);
+
+                return true;
+            }
+        } catch (const std::exception& error) {
+            std::stringstream stream;
+
+            printErrorToStream(error, stream);
+            vm->TraceStack(
+                stream.str().c_str(),
+                stackId,
+                RE::BSScript::ErrorLogger::Severity::kInfo);
+        }
+
+        return false;
+    }
+
+    template <typename T>
+    std::vector<T> GetValues(
+        RE::BSScript::Internal::VirtualMachine* const vm,
+        const RE::VMStackID stackId,
+        RE::StaticFunctionTag*,
+        const ConfigManager::HandleType handle,
+        const std::vector<RE::BSFixedString> keys,
+        const std::vector<T> defaultValues)
+    {
+        if (!validateBatch_(vm, stackId, keys, defaultValues.size())) {
+            return defaultValues;
+        }
+
+        try {
+            const auto config = ConfigManager::getInstance().getConfig(handle);
+
+            if (config != nullptr) {
+                return config->getAll(keys, defaultValues);
+            }
+        } catch (const std::exception& error) {
+            std::stringstream stream;
+
+            printErrorToStream(error, stream);
+            vm->TraceStack(
+                stream.str().c_str(),
+                stackId,
+                RE::BSScript::ErrorLogger::Severity::kInfo);
+        }
+
+        return defaultValues;
+    }
+
+    int GetConfigCount(
+        RE::BSScript::Internal::VirtualMachine* const vm,
+        const RE::VMStackID stackId,
+        RE::StaticFunctionTag*)
+    {
+        try {
+            // This truncates the value since std::size_t is defined (in this
+            // writing's context) as 'unsigned long long' while we're return an int.
+            //
+            // However, this is unavoidable since Papyrus has no support for an
+            // integer of this size and, short of an actual bug causing a bunch of
+            // open configurations, should never happen anyway.
+            return static_cast<int>(ConfigManager::getInstance().size());
+        } catch (const std::exception& error) {
+            std::stringstream stream;
+
+            printErrorToStream(error, stream);
+            vm->TraceStack(
+                stream.str().c_str(),
+                stackId,
+                RE::BSScript::ErrorLogger::Severity::kInfo);
+        }
+
+        return 0;
+    }
+
+    ConfigManager::HandleType GetLargestHandle(
+        RE::BSScript::Internal::VirtualMachine* const vm,
+        const RE::VMStackID stackId,
+        RE::StaticFunctionTag*)
+    {
+        try {
+            return ConfigManager::getInstance().getLargestHandle();
+        } catch (const std::exception& error) {
+            std::stringstream stream;
+
+            printErrorToStream(error, stream);
+            vm->TraceStack(
+                stream.str().c_str(),
+                stackId,
+                RE::BSScript::ErrorLogger::Severity::kInfo);
+        }
+
+        return 0;
+    }
+
+    ConfigManager::HandleType GetNextHandle(
+        RE::BSScript::Internal::VirtualMachine* const vm,
+        const RE::VMStackID stackId,
+        RE::StaticFunctionTag*)
+    {
+        try {
+            return ConfigManager::getInstance().getNextHandle();
+        } catch (const std::exception& error) {
+            std::stringstream stream;
+
+            printErrorToStream(error, stream);
+            vm->TraceStack(
+                stream.str().c_str(),
+                stackId,
+                RE::BSScript::ErrorLogger::Severity::kInfo);
+        }
+
+        return 0;
+    }
+
+    void CloseAllConfigs(
+        RE::BSScript::Internal::VirtualMachine* const vm,
+        const RE::VMStackID stackId,
+        RE::StaticFunctionTag*)
+    {
+        try {
+            ConfigManager::getInstance().closeAllConfigs();
+        } catch (const std::exception& error) {
+            std::stringstream stream;
+
+            printErrorToStream(error, stream);
+            vm->TraceStack(
+                stream.str().c_str(),
+                stackId,
+                RE::BSScript::ErrorLogger::Severity::kInfo);
+        }
+    }
+
+    std::vector<std::string> ListConfigHandles(
+        RE::BSScript::Internal::VirtualMachine* const vm,
+        const RE::VMStackID stackId,
+        RE::StaticFunctionTag*)
+    {
+        std::vector<std::string> results;
+
+        try {
+            const auto handles = ConfigManager::getInstance().listHandles();
+
+            for (const auto& info : handles) {
+                results.push_back(fmt::format(
+                    FMT_STRING("{}: {} ({} bytes, idle {}s{})"sv),
+                    info.handle,
+                    info.owner.empty() ? "<unknown>"sv
+                                       : std::string_view(info.owner),
+                    info.memoryUsage,
+                    info.idleTime.count(),
+                    info.isSpilled ? ", spilled"sv : ""sv));
+            }
+        } catch (const std::exception& error) {
+            std::stringstream stream;
+
+            printErrorToStream(error, stream);
+            vm->TraceStack(
+                stream.str().c_str(),
+                stackId,
+                RE::BSScript::ErrorLogger::Severity::kInfo);
+        }
+
+        return results;
+    }
+
+    void SetConfigMemoryBudget(
+        RE::BSScript::Internal::VirtualMachine* const vm,
+        const RE::VMStackID stackId,
+        RE::StaticFunctionTag*,
+        const int budgetKilobytes,
+        const int minIdleSeconds)
+    {
+        if (budgetKilobytes < 0 || minIdleSeconds < 0) {
+            vm->TraceStack("Budget and idle time can't be negative", stackId);
+            return;
+        }
+
+        try {
+            ConfigManager::getInstance().setMemoryBudget(
+                static_cast<std::size_t>(budgetKilobytes) * 1024,
+                std::chrono::seconds(minIdleSeconds));
+        } catch (const std::exception& error) {
+            std::stringstream stream;
+
+            printErrorToStream(error, stream);
+            vm->TraceStack(
+                stream.str().c_str(),
+                stackId,
+                RE::BSScript::ErrorLogger::Severity::kInfo);
+        }
+    }
+
+    /**
+     * @brief Returns the result of a latent native to the waiting script,
+     * tracing the error message first if there is one. Can be called from any
+     * thread.
+     */
+    template <typename R>
+    void returnLatentResult_(
+        VirtualMachine* const vm,
+        const RE::VMStackID stackId,
+        const R result,
+        std::string errorMessage = "")
+    {
+        // The VM may only be touched from the game's threads.
+        SKSE::GetTaskInterface()->AddTask(
+            [vm, stackId, result, errorMessage = std::move(errorMessage)]() {
+                if (!errorMessage.empty()) {
+                    vm->TraceStack(
+                        errorMessage.c_str(),
+                        stackId,
+                        RE::BSScript::ErrorLogger::Severity::kInfo);
+                }
+
+                vm->ReturnLatentResult(stackId, result);
+            });
+    }
+
+    /**
+     * @brief Runs fn on the I/O executor and returns its result to the waiting
+     * script. If fn throws, the error is traced and failureValue is returned
+     * instead.
+     *
+     * @returns The value for the latent native to return to the VM.
+     */
+    template <typename R, typename Fn>
+    bool runLatent_(
+        VirtualMachine* const vm,
+        const RE::VMStackID stackId,
+        const R failureValue,
+        Fn&& fn)
+    {
+        getIoExecutor()->submit(
+            [vm, stackId, failureValue, fn = std::forward<Fn>(fn)]() {
+                R result = failureValue;
+                std::string errorMessage;
+
+                try {
+                    result = fn();
+                } catch (const std::exception& error) {
+                    std::stringstream stream;
+
+                    printErrorToStream(error, stream);
+                    errorMessage = stream.str();
+                }
+
+                returnLatentResult_(
+                    vm,
+                    stackId,
+                    result,
+                    std::move(errorMessage));
+            });
+
+        return true;
+    }
+
+    std::filesystem::path toDataPath_(const RE::BSFixedString& path)
+    {
+        std::filesystem::path filePath("Data");
+        filePath /= path.c_str();
+
+        return filePath;
+    }
+
+    bool FileExistsAsync(
+        VirtualMachine* const vm,
+        const RE::VMStackID stackId,
+        RE::StaticFunctionTag*,
+        const RE::BSFixedString path)
+    {
+        return runLatent_(vm, stackId, false, [filePath = toDataPath_(path)] {
+            ConfigWriter::getInstance().flush(filePath);
+
+            return DirectoryIndex::getInstance().exists(filePath);
+        });
+    }
+
+    bool RemoveFileAsync(
+        VirtualMachine* const vm,
+        const RE::VMStackID stackId,
+        RE::StaticFunctionTag*,
+        const RE::BSFixedString path)
+    {
+        return runLatent_(vm, stackId, false, [filePath = toDataPath_(path)] {
+            ConfigWriter::getInstance().flush(filePath);
+
+            const auto isRemoved = std::filesystem::remove(filePath);
+            DirectoryIndex::getInstance().invalidate(filePath.parent_path());
+
+            return isRemoved;
+        });
+    }
+
+    bool OpenConfigAsync(
+        VirtualMachine* const vm,
+        const RE::VMStackID stackId,
+        RE::StaticFunctionTag*,
+        const RE::BSFixedString path)
+    {
+        const auto isPathEmpty = path.length() <= 0;
+
+        return runLatent_(
+            vm,
+            stackId,
+            ConfigManager::HandleType{0},
+            [isPathEmpty,
+             filePath = toDataPath_(path),
+             owner = getCallingScriptName_(vm, stackId)] {
+                if (isPathEmpty) {
+                    throw std::invalid_argument("File path is empty");
+                }
+
+                return ConfigManager::getInstance().openConfig(filePath, owner);
+            });
+    }
+
+    bool SaveConfigAsync(
+        VirtualMachine* const vm,
+        const RE::VMStackID stackId,
+        RE::StaticFunctionTag*,
+        const ConfigManager::HandleType handle,
+        const RE::BSFixedString path)
+    {
+        getIoExecutor()->submit(
+            [vm, stackId, handle, filePath = toDataPath_(path)] {
+                try {
+                    // Unlike SaveConfig(), only return once the file is
+                    // written. The writer returns the result, so that this
+                    // executor isn't blocked in the meantime.
+                    auto& configManager = ConfigManager::getInstance();
+                    const bool isQueued = configManager.saveConfig(
+                        handle,
+                        filePath,
+                        [vm, stackId](const bool isWritten) {
+                            returnLatentResult_(vm, stackId, isWritten);
+                        });
+
+                    if (!isQueued) {
+                        returnLatentResult_(vm, stackId, false);
+                    }
+                } catch (const std::exception& error) {
+                    std::stringstream stream;
+
+                    printErrorToStream(error, stream);
+                    returnLatentResult_(vm, stackId, false, stream.str());
+                }
+            });
+
+        return true;
+    }
+
+    void handleMessage_(SKSE::MessagingInterface::Message* const message)
+    {
+        if (message->type == SKSE::MessagingInterface::kSaveGame) {
+            // Put the files saved by SaveConfigAsync() calls that are still
+            // waiting on disk along with the save.
+            ConfigWriter::getInstance().flushAll();
+        } else if (
+            message->type == SKSE::MessagingInterface::kNewGame ||
+            message->type == SKSE::MessagingInterface::kPreLoadGame) {
+            // Directories listed by the previous game are unlikely to be
+            // queried again, so don't let the index grow across sessions.
+            DirectoryIndex::getInstance().clear();
+        }
+    }
+
+    bool registerPapyrusFunctions_(VirtualMachine* const vm)
+    {
+        if (vm == nullptr) {
+            LOG_ERROR("Couldn't get VM State"sv);
+            return false;
+        }
+
+        PapyrusFunctionRegistry registry("YASTMFSUtils", vm);
+
+        // General file system functions
+        registry.registerFunction("FileExists", FileExists);
+        registry.registerFunction("RemoveFile", RemoveFile);
+        registry.registerFunction("FilesExist", FilesExist);
+        registry.registerFunction("ListFiles", ListFiles);
+
+        // Functions handling configuration files.
+        registry.registerFunction("CreateConfig", CreateConfig);
+        registry.registerFunction("OpenConfig", OpenConfig);
+        registry.registerFunction("SaveConfig", SaveConfig);
+        registry.registerFunction("CloseConfig", CloseConfig);
+        registry.registerFunction("ConvertConfig", ConvertConfig);
+
+        // Latent versions of the file operations above. The calling script
+        // waits while the file is accessed on a background thread, but other
+        // scripts keep running.
+        registry.registerLatentFunction<bool>(
+            "FileExistsAsync",
+            FileExistsAsync);
+        registry.registerLatentFunction<bool>(
+            "RemoveFileAsync",
+            RemoveFileAsync);
+        registry.registerLatentFunction<ConfigManager::HandleType>(
+            "OpenConfigAsync",
+            OpenConfigAsync);
+        registry.registerLatentFunction<bool>(
+            "SaveConfigAsync",
+            SaveConfigAsync);
+
+        registry.registerFunction("HasEntry", HasEntry);
+        registry.registerFunction("GetInt", GetValue<int>);
+        registry.registerFunction("GetFloat", GetValue<float>);
+        registry.registerFunction("SetInt", SetValue<int>);
+        registry.registerFunction("SetFloat", SetValue<float>);
+
+        // Versions of the functions above taking compiled key paths.
+        registry.registerFunction("CompilePath", CompilePath);
+        registry.registerFunction("HasEntryAt", HasEntryAt);
+        registry.registerFunction("GetIntAt", GetValueAt<int>);
+        registry.registerFunction("GetFloatAt", GetValueAt<float>);
+        registry.registerFunction("SetIntAt", SetValueAt<int>);
+        registry.registerFunction("SetFloatAt", SetValueAt<float>);
+
+        // Batched versions of the functions above, for reading or writing many
+        // entries in one call.
+        registry.registerFunction("HasEntries", HasEntries);
+        registry.registerFunction("GetInts", GetValues<int>);
+        registry.registerFunction("GetFloats", GetValues<float>);
+        registry.registerFunction("SetInts", SetValues<int>);
+        registry.registerFunction("SetFloats", SetValues<float>);
+        registry.registerFunction("SetMixedValues", SetMixedValues);
+
+        // Functions for debugging purposes.
+        registry.registerFunction("GetConfigCount", GetConfigCount);
+        registry.registerFunction("GetLargestHandle", GetLargestHandle);
+        registry.registerFunction("GetNextHandle", GetNextHandle);
+        registry.registerFunction("CloseAllConfigs", CloseAllConfigs);
+        registry.registerFunction("ListConfigHandles", ListConfigHandles);
+
+        // Functions for managing the memory used by open configurations.
+        registry.registerFunction(
+            "SetConfigMemoryBudget",
+            SetConfigMemoryBudget);
+
+        return true;
+    }
+} // namespace
+
+bool registerFSUtils(const SKSE::PapyrusInterface* const papyrus)
+{
+    // Spilled configurations don't outlive the session that spilled them.
+    ConfigManager::clearSpillDirectory();
+    SKSE::GetMessagingInterface()->RegisterListener(handleMessage_);
+
+    return papyrus->Register(registerPapyrusFunctions_);
+}
@@ -1,7 +1,7 @@
-#pragma once
-
-namespace SKSE {
-    class PapyrusInterface;
-}
-
-bool registerFSUtils(const SKSE::PapyrusInterface* papyrus);
+#pragma once
+
+namespace SKSE {
+    class PapyrusInterface;
+}
+
+bool registerFSUtils(const SKSE::PapyrusInterface* papyrus);
@@ -0,0 +1,440 @@
+#include "BinaryConfigStore.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "ConfigWriter.hpp"
+#include "../../global.hpp"
+#include "../../utilities/memoryutils.hpp"
+
+// Note to Future Me: Do not handle exceptions here. Let them propagate to the
+//                    actual Papyrus call so that we have access to the
+//                    Papyrus VM context for logging.
+
+using namespace std::literals;
+
+namespace {
+    constexpr auto Magic_ = "YKV1"sv;
+    constexpr std::size_t HeaderSize_ = 16;
+    constexpr std::size_t IndexEntrySize_ = 16;
+    constexpr std::size_t LogRecordHeaderSize_ = 12;
+
+    /**
+     * @brief The log is merged into the base once it has more records than
+     * this plus a quarter of the base record count.
+     */
+    constexpr std::size_t MinLogRecordsBeforeCompaction_ = 32;
+
+    enum class ValueType_ : std::uint8_t {
+        Int = 0,
+        Float = 1,
+    };
+
+    template <typename T>
+    T read_(const char* const data)
+    {
+        T value;
+        std::memcpy(&value, data, sizeof(T));
+        return value;
+    }
+
+    template <typename T>
+    void append_(std::string& out, const T value)
+    {
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        out.append(bytes, sizeof(T));
+    }
+
+    ValueType_ typeOf_(const ConfigValue& value)
+    {
+        return std::holds_alternative<std::int64_t>(value) ? ValueType_::Int
+                                                           : ValueType_::Float;
+    }
+
+    std::uint64_t bitsOf_(const ConfigValue& value)
+    {
+        return std::visit(
+            [](const auto value) {
+                std::uint64_t bits;
+                std::memcpy(&bits, &value, sizeof(bits));
+                return bits;
+            },
+            value);
+    }
+
+    ConfigValue decodeValue_(const std::uint8_t type, const std::uint64_t bits)
+    {
+        switch (static_cast<ValueType_>(type)) {
+        case ValueType_::Int:
+            return static_cast<std::int64_t>(bits);
+        case ValueType_::Float: {
+            double value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+        }
+
+        throw std::runtime_error("Invalid value type in binary configuration");
+    }
+
+    std::uint16_t checkedKeyLength_(const std::string_view key)
+    {
+        if (key.size() > std::numeric_limits<std::uint16_t>::max()) {
+            throw std::invalid_argument("Key is too long");
+        }
+
+        return static_cast<std::uint16_t>(key.size());
+    }
+
+    void appendLogRecord_(
+        std::string& out,
+        const std::string_view key,
+        const ConfigValue& value)
+    {
+        append_(out, checkedKeyLength_(key));
+        append_(out, static_cast<std::uint8_t>(typeOf_(value)));
+        append_(out, std::uint8_t{0});
+        append_(out, bitsOf_(value));
+        out.append(key);
+    }
+} // namespace
+
+BinaryConfigStore::BinaryConfigStore(const std::filesystem::path& path)
+    : file_(std::make_shared<const MappedFile>(path))
+{
+    validateBase_();
+    readLog_(path.string());
+
+    ConfigWriter::getInstance().recordContents(
+        path,
+        data_().substr(0, validSize_));
+}
+
+BinaryConfigStore::BinaryConfigStore(
+    std::shared_ptr<const std::string> contents)
+    : contents_(std::move(contents))
+{
+    validateBase_();
+    readLog_("(compacted contents)"sv);
+}
+
+void BinaryConfigStore::validateBase_()
+{
+    const auto buffer = data_();
+    const auto invalid = [] {
+        return std::runtime_error("Invalid binary configuration file");
+    };
+
+    if (buffer.size() < HeaderSize_ ||
+        std::string_view(buffer.data(), Magic_.size()) != Magic_) {
+        throw invalid();
+    }
+
+    const auto recordCount = read_<std::uint32_t>(buffer.data() + 4);
+    const auto baseSize = read_<std::uint64_t>(buffer.data() + 8);
+
+    if (baseSize > buffer.size() ||
+        HeaderSize_ + std::uint64_t{recordCount} * IndexEntrySize_ > baseSize) {
+        throw invalid();
+    }
+
+    recordCount_ = recordCount;
+    baseSize_ = static_cast<std::size_t>(baseSize);
+
+    std::string_view previousKey;
+
+    for (std::uint32_t i = 0; i < recordCount_; ++i) {
+        const auto entry = buffer.data() + HeaderSize_ + i * IndexEntrySize_;
+        const auto keyOffset = read_<std::uint32_t>(entry);
+        const auto keyLength = read_<std::uint16_t>(entry + 4);
+        const auto type = read_<std::uint8_t>(entry + 6);
+
+        if (std::uint64_t{keyOffset} + keyLength > baseSize_ ||
+            type > static_cast<std::uint8_t>(ValueType_::Float)) {
+            throw invalid();
+        }
+
+        // Binary search relies on the keys being sorted.
+        const auto key = keyAt_(i);
+
+        if (i > 0 && key <= previousKey) {
+            throw invalid();
+        }
+
+        previousKey = key;
+    }
+}
+
+void BinaryConfigStore::readLog_(const std::string_view source)
+{
+    const auto buffer = data_();
+    std::size_t offset = baseSize_;
+
+    while (offset + LogRecordHeaderSize_ <= buffer.size()) {
+        const auto record = buffer.data() + offset;
+        const auto keyLength = read_<std::uint16_t>(record);
+        const auto type = read_<std::uint8_t>(record + 2);
+        const auto bits = read_<std::uint64_t>(record + 4);
+
+        if (offset + LogRecordHeaderSize_ + keyLength > buffer.size() ||
+            type > static_cast<std::uint8_t>(ValueType_::Float)) {
+            // A truncated or corrupt record can only be at the end of the
+            // file, so ignore the rest of it.
+            break;
+        }
+
+        log_.insert_or_assign(
+            std::string(record + LogRecordHeaderSize_, keyLength),
+            decodeValue_(type, bits));
+
+        offset += LogRecordHeaderSize_ + keyLength;
+    }
+
+    if (offset < buffer.size()) {
+        // Most likely a save that was interrupted while appending. The next
+        // save overwrites the dropped bytes.
+        LOG_WARN_FMT(
+            "Dropped {} bytes of corrupt log records at the end of binary "
+            "configuration file \"{}\"."sv,
+            buffer.size() - offset,
+            source);
+    }
+
+    validSize_ = offset;
+}
+
+std::string_view BinaryConfigStore::keyAt_(const std::uint32_t index) const
+{
+    const auto data = data_().data();
+    const auto entry = data + HeaderSize_ + index * IndexEntrySize_;
+
+    return std::string_view(
+        data + read_<std::uint32_t>(entry),
+        read_<std::uint16_t>(entry + 4));
+}
+
+ConfigValue BinaryConfigStore::valueAt_(const std::uint32_t index) const
+{
+    const auto entry = data_().data() + HeaderSize_ + index * IndexEntrySize_;
+
+    return decodeValue_(
+        read_<std::uint8_t>(entry + 6),
+        read_<std::uint64_t>(entry + 8));
+}
+
+std::optional<ConfigValue>
+    BinaryConfigStore::findInBase_(const std::string_view key) const
+{
+    std::uint32_t low = 0;
+    std::uint32_t high = recordCount_;
+
+    while (low < high) {
+        const auto middle = low + (high - low) / 2;
+        const auto comparison = keyAt_(middle).compare(key);
+
+        if (comparison == 0) {
+            return valueAt_(middle);
+        }
+
+        if (comparison < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    return std::nullopt;
+}
+
+std::optional<ConfigValue>
+    BinaryConfigStore::find_(const std::string_view key) const
+{
+    // Log records are newer than the base.
+    if (const auto it = log_.find(key); it != log_.end()) {
+        return it->second;
+    }
+
+    return findInBase_(key);
+}
+
+std::optional<std::int64_t>
+    BinaryConfigStore::getInt(const std::string_view key, PathSegments) const
+{
+    const auto value = find_(key);
+
+    if (!value.has_value()) {
+        return std::nullopt;
+    }
+
+    if (const auto intValue = std::get_if<std::int64_t>(&*value);
+        intValue != nullptr) {
+        return *intValue;
+    }
+
+    // Like TOML, only convert floats that are exact integers.
+    const auto floatValue = std::get<double>(*value);
+
+    if (std::trunc(floatValue) == floatValue &&
+        floatValue >= static_cast<double>(
+                          std::numeric_limits<std::int64_t>::min()) &&
+        floatValue < static_cast<double>(
+                         std::numeric_limits<std::int64_t>::max())) {
+        return static_cast<std::int64_t>(floatValue);
+    }
+
+    return std::nullopt;
+}
+
+std::optional<double>
+    BinaryConfigStore::getFloat(const std::string_view key, PathSegments) const
+{
+    const auto value = find_(key);
+
+    if (!value.has_value()) {
+        return std::nullopt;
+    }
+
+    return std::visit(
+        [](const auto value) { return static_cast<double>(value); },
+        *value);
+}
+
+bool BinaryConfigStore::insert(
+    const std::string_view key,
+    PathSegments,
+    const ConfigValue& value)
+{
+    if (find_(key).has_value()) {
+        return false;
+    }
+
+    checkedKeyLength_(key);
+    log_.emplace(key, value);
+    insertedKeys_.emplace_back(key);
+
+    return true;
+}
+
+std::size_t BinaryConfigStore::forEachValue(const ValueCallback& fn) const
+{
+    for (std::uint32_t i = 0; i < recordCount_; ++i) {
+        const auto key = keyAt_(i);
+
+        if (!log_.contains(key)) {
+            fn(key, valueAt_(i));
+        }
+    }
+
+    for (const auto& [key, value] : log_) { fn(key, value); }
+
+    return 0;
+}
+
+std::string BinaryConfigStore::serialize() const
+{
+    if (data_().empty() ||
+        log_.size() > MinLogRecordsBeforeCompaction_ + recordCount_ / 4) {
+        return serializeCompacted_();
+    }
+
+    // Keep the file contents as they are and add the new records after them,
+    // so that the file can be appended to.
+    std::string out(data_().substr(0, validSize_));
+
+    for (const auto& key : insertedKeys_) {
+        appendLogRecord_(out, key, log_.find(key)->second);
+    }
+
+    return out;
+}
+
+std::unique_ptr<ConfigStore>
+    BinaryConfigStore::releaseFile(const std::string& contents) const
+{
+    // Appending to a mapped file works, so only let go of it when the
+    // contents replace it. ConfigWriter also replaces a file that has corrupt
+    // records at the end instead of appending to it.
+    if (file_ == nullptr ||
+        (validSize_ == file_->size() &&
+         std::string_view(contents).starts_with(file_->view()))) {
+        return nullptr;
+    }
+
+    return std::make_unique<BinaryConfigStore>(
+        std::make_shared<const std::string>(contents));
+}
+
+std::size_t BinaryConfigStore::estimateMemoryUsage() const
+{
+    // std::map nodes hold three links and a color flag besides the value.
+    constexpr std::size_t nodeOverhead = 4 * sizeof(void*);
+
+    // The mapped file is backed by the file itself, so it isn't counted.
+    std::size_t size = sizeof(*this);
+
+    if (contents_ != nullptr) {
+        size += estimateHeapMemoryUsage(*contents_);
+    }
+
+    for (const auto& [key, value] : log_) {
+        size += sizeof(LogMap::value_type) + nodeOverhead +
+                estimateHeapMemoryUsage(key);
+    }
+
+    for (const auto& key : insertedKeys_) {
+        size += sizeof(key) + estimateHeapMemoryUsage(key);
+    }
+
+    return size;
+}
+
+std::string BinaryConfigStore::serializeCompacted_() const
+{
+    std::vector<std::pair<std::string_view, ConfigValue>> records;
+    records.reserve(recordCount_ + log_.size());
+
+    forEachValue([&](const std::string_view key, const ConfigValue& value) {
+        records.emplace_back(key, value);
+    });
+
+    std::ranges::sort(records, {}, &decltype(records)::value_type::first);
+
+    std::size_t keysSize = 0;
+
+    for (const auto& [key, value] : records) { keysSize += key.size(); }
+
+    const auto indexSize = records.size() * IndexEntrySize_;
+    const auto baseSize = HeaderSize_ + indexSize + keysSize;
+
+    if (baseSize > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::runtime_error("Configuration is too large");
+    }
+
+    std::string out;
+    out.reserve(baseSize);
+
+    out.append(Magic_);
+    append_(out, static_cast<std::uint32_t>(records.size()));
+    append_(out, static_cast<std::uint64_t>(baseSize));
+
+    auto keyOffset = static_cast<std::uint32_t>(HeaderSize_ + indexSize);
+
+    for (const auto& [key, value] : records) {
+        append_(out, keyOffset);
+        append_(out, checkedKeyLength_(key));
+        append_(out, static_cast<std::uint8_t>(typeOf_(value)));
+        append_(out, std::uint8_t{0});
+        append_(out, bitsOf_(value));
+
+        keyOffset += static_cast<std::uint32_t>(key.size());
+    }
+
+    for (const auto& [key, value] : records) { out.append(key); }
+
+    return out;
+}
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ConfigStore.hpp"
+#include "MappedFile.hpp"
+
+/**
+ * @brief Stores a configuration as flat key-value records in a compact binary
+ * file (".ykv").
+ *
+ * @details The file starts with a sorted base section that is searched in
+ * place, without building any in-memory structure:
+ *
+ *     Header (16 bytes):
+ *         char[4]  magic ("YKV1")
+ *         uint32   record count
+ *         uint64   base size (offset of the log)
+ *     Index (16 bytes per record, sorted by key):
+ *         uint32   key offset
+ *         uint16   key length
+ *         uint8    value type (0 = int, 1 = float)
+ *         uint8    reserved
+ *         uint64   value (int64 or double bits)
+ *     Key data
+ *
+ * It is followed by an append-only log of records added since the base was
+ * last rewritten:
+ *
+ *     uint16   key length
+ *     uint8    value type
+ *     uint8    reserved
+ *     uint64   value
+ *     char[]   key
+ *
+ * Keys are full dotted paths. All numbers are little-endian. Saving appends the
+ * new records to the log, and the log is only merged into the base once it
+ * grows large relative to it. Since serialize() keeps the existing file
+ * contents as a prefix, ConfigWriter only has to append the new records.
+ *
+ * The store reads the file through a MappedFile that it keeps open for its
+ * lifetime, so lookups in the base never copy it. Opening the file records its
+ * contents with ConfigWriter, so that the first save after opening it already
+ * appends. A mapped file can't be replaced on Windows, so before a compacted
+ * file is written, the store is replaced with one that reads the compacted
+ * contents from memory (see releaseFile()).
+ */
+class BinaryConfigStore : public ConfigStore {
+    using LogMap = std::map<std::string, ConfigValue, std::less<>>;
+
+    /**
+     * @brief The file the store was opened from. Shared with clones.
+     */
+    std::shared_ptr<const MappedFile> file_;
+    /**
+     * @brief The contents the store was compacted into, instead of file_.
+     * Shared with clones.
+     */
+    std::shared_ptr<const std::string> contents_;
+    std::uint32_t recordCount_ = 0;
+    std::size_t baseSize_ = 0;
+    /**
+     * @brief The size of the base and the valid part of the log, in bytes.
+     */
+    std::size_t validSize_ = 0;
+
+    /**
+     * @brief Records from the file's log and records inserted since opening.
+     */
+    LogMap log_;
+    /**
+     * @brief Keys inserted since opening, in insertion order.
+     */
+    std::vector<std::string> insertedKeys_;
+
+    std::string_view data_() const noexcept
+    {
+        if (file_ != nullptr) {
+            return file_->view();
+        }
+
+        return contents_ != nullptr ? *contents_ : std::string_view();
+    }
+
+    std::string_view keyAt_(std::uint32_t index) const;
+    ConfigValue valueAt_(std::uint32_t index) const;
+    std::optional<ConfigValue> findInBase_(std::string_view key) const;
+    std::optional<ConfigValue> find_(std::string_view key) const;
+
+    void validateBase_();
+    /**
+     * @param[in] source The file name to use in log messages.
+     */
+    void readLog_(std::string_view source);
+
+    /**
+     * @brief Returns the file contents with the log merged into a new base.
+     */
+    std::string serializeCompacted_() const;
+
+public:
+    explicit BinaryConfigStore() {}
+    explicit BinaryConfigStore(const std::filesystem::path& path);
+    /**
+     * @brief Reads the store from contents in memory.
+     */
+    explicit BinaryConfigStore(std::shared_ptr<const std::string> contents);
+
+    ConfigFormat format() const noexcept override
+    {
+        return ConfigFormat::Binary;
+    }
+
+    bool has(std::string_view key, PathSegments) const override
+    {
+        return find_(key).has_value();
+    }
+
+    std::optional<std::int64_t>
+        getInt(std::string_view key, PathSegments) const override;
+    std::optional<double>
+        getFloat(std::string_view key, PathSegments) const override;
+
+    std::unique_ptr<ConfigStore> clone() const override
+    {
+        // The file contents are immutable, so only the log is copied.
+        return std::make_unique<BinaryConfigStore>(*this);
+    }
+
+    bool insert(
+        std::string_view key,
+        PathSegments segments,
+        const ConfigValue& value) override;
+
+    std::size_t forEachValue(const ValueCallback& fn) const override;
+
+    std::string serialize() const override;
+    std::unique_ptr<ConfigStore>
+        releaseFile(const std::string& contents) const override;
+
+    std::size_t estimateMemoryUsage() const override;
+};
@@ -1,21 +1,209 @@
-#include "Config.hpp"
-
-#include <fstream>
-
-// Note to Future Me: Do not handle exceptions here. Let them propagate to the
-//                    actual Papyrus call so that we have access to the
-//                    Papyrus VM context for logging.
-
-Config::Config(std::string_view path)
-    : data_(toml::parse_file(path))
-{}
-
-bool Config::writeToDisk(const std::filesystem::path& filePath) const
-{
-    std::shared_lock lock(mutex_);
-
-    std::ofstream configFile(filePath);
-    configFile << data_;
-
-    return true;
-}
+#include "Config.hpp"
+
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#include "ParsedConfigCache.hpp"
+#include "TomlConfigStore.hpp"
+
+// Note to Future Me: Do not handle exceptions here. Let them propagate to the
+//                    actual Papyrus call so that we have access to the
+//                    Papyrus VM context for logging.
+
+namespace {
+    bool isSamePath_(
+        const std::filesystem::path& lhs,
+        const std::filesystem::path& rhs)
+    {
+        return lhs.lexically_normal() == rhs.lexically_normal();
+    }
+} // namespace
+
+Config::Config(const std::string_view owner)
+    : snapshot_(std::make_shared<TomlConfigStore>())
+    , owner_(owner)
+{
+    touch();
+}
+
+Config::Config(
+    const std::filesystem::path& path,
+    const std::string_view owner)
+    : snapshot_(openConfigStore(path))
+    , owner_(owner)
+    , savedPath_(path)
+{
+    touch();
+}
+
+Config::~Config()
+{
+    if (spillPath_.has_value()) {
+        std::error_code error;
+        std::filesystem::remove(*spillPath_, error);
+    }
+}
+
+Config::StorePointer Config::reload_() const
+{
+    if (auto snapshot = snapshot_.load(); snapshot != nullptr) {
+        return snapshot;
+    }
+
+    StorePointer snapshot = openConfigStore(*spillPath_);
+    snapshot_.store(snapshot);
+
+    // The spill file is only read once, so don't keep it cached.
+    ParsedConfigCache::getInstance().erase(*spillPath_);
+
+    std::error_code error;
+    std::filesystem::remove(*spillPath_, error);
+    spillPath_.reset();
+
+    return snapshot;
+}
+
+ConfigStore& Config::mutableStore_()
+{
+    if (pendingStore_ == nullptr) {
+        pendingStore_ = reload_()->clone();
+        hasPendingChanges_.store(true);
+
+        // Tasks run on the main thread at the start of the next frame. The
+        // configuration may be closed by then.
+        SKSE::GetTaskInterface()->AddTask([weakThis = weak_from_this()] {
+            if (const auto config = weakThis.lock(); config != nullptr) {
+                config->publish();
+            }
+        });
+    }
+
+    return *pendingStore_;
+}
+
+void Config::publish_()
+{
+    if (pendingStore_ == nullptr) {
+        return;
+    }
+
+    // The snapshot must be stored before the flag is cleared. See find_().
+    snapshot_.store(std::move(pendingStore_));
+    pendingStore_.reset();
+    hasPendingChanges_.store(false);
+}
+
+void Config::publish()
+{
+    std::lock_guard lock(mutex_);
+
+    publish_();
+}
+
+std::size_t Config::estimateMemoryUsage() const
+{
+    std::lock_guard lock(mutex_);
+
+    if (pendingStore_ != nullptr) {
+        return pendingStore_->estimateMemoryUsage();
+    }
+
+    const auto snapshot = snapshot_.load();
+
+    return snapshot != nullptr ? snapshot->estimateMemoryUsage() : 0;
+}
+
+bool Config::spill(const std::filesystem::path& spillPathStem)
+{
+    std::lock_guard lock(mutex_);
+
+    publish_();
+
+    const auto snapshot = snapshot_.load();
+
+    if (snapshot == nullptr) {
+        return false;
+    }
+
+    auto spillPath = spillPathStem;
+    spillPath += getFileExtension(snapshot->format());
+
+    // Write directly rather than through ConfigWriter, since the data must be
+    // on disk before it's released.
+    std::filesystem::create_directories(spillPath.parent_path());
+
+    {
+        std::ofstream file(spillPath, std::ios::binary | std::ios::trunc);
+        file << snapshot->serialize();
+
+        if (!file) {
+            file.close();
+
+            std::error_code error;
+            std::filesystem::remove(spillPath, error);
+
+            throw std::runtime_error(
+                "Could not write spill file \"" + spillPath.string() + "\"");
+        }
+    }
+
+    // Readers still holding the snapshot keep it alive until they're done.
+    snapshot_.store(nullptr);
+    spillPath_ = std::move(spillPath);
+
+    return true;
+}
+
+std::optional<Config::SaveData>
+    Config::serializeForSave(const std::filesystem::path& filePath)
+{
+    std::lock_guard lock(mutex_);
+
+    if (version_ == savedVersion_ && savedPath_.has_value() &&
+        isSamePath_(*savedPath_, filePath) &&
+        std::filesystem::exists(filePath)) {
+        return std::nullopt;
+    }
+
+    publish_();
+
+    const auto snapshot = reload_();
+    std::string contents;
+
+    if (const auto format = getConfigFormat(filePath);
+        format == snapshot->format()) {
+        contents = snapshot->serialize();
+
+        // The contents may be written over the file the snapshot reads from.
+        // Readers still holding the old snapshot let go of it shortly.
+        if (auto released = snapshot->releaseFile(contents);
+            released != nullptr) {
+            snapshot_.store(std::move(released));
+        }
+    } else {
+        // Entries that the target format can't store are left out.
+        std::size_t skippedCount = 0;
+        contents = serializeAs(*snapshot, format, skippedCount);
+    }
+
+    return SaveData{std::move(contents), version_};
+}
+
+void Config::markSaved(
+    const std::filesystem::path& filePath,
+    const std::uint64_t version)
+{
+    std::lock_guard lock(mutex_);
+
+    // An older write to the same path may finish after a newer one was
+    // confirmed.
+    if (savedPath_.has_value() && isSamePath_(*savedPath_, filePath) &&
+        version < savedVersion_) {
+        return;
+    }
+
+    savedVersion_ = version;
+    savedPath_ = filePath;
+}
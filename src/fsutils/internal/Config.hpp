@@ -1,38 +1,473 @@
-#pragma once
-
-#include <shared_mutex>
-
-#include <toml++/toml.h>
-
-class Config {
-    toml::table data_;
-    mutable std::shared_mutex mutex_;
-
-public:
-    Config() {}
-    Config(std::string_view path);
-
-    bool has(std::string_view key) const
-    {
-        std::shared_lock lock(mutex_);
-        return data_.contains(key);
-    }
-
-    template <typename T>
-    T get(std::string_view key, const T& defaultValue) const
-    {
-        std::shared_lock lock(mutex_);
-
-        return data_[key].value_or(defaultValue);
-    }
-
-    template <typename T>
-    void set(std::string_view key, const T value)
-    {
-        std::unique_lock lock(mutex_);
-
-        data_.insert(key, value);
-    }
-
-    bool writeToDisk(const std::filesystem::path& filePath) const;
-};
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ConfigPath.hpp"
+#include "ConfigStore.hpp"
+
+class Config : public std::enable_shared_from_this<Config> {
+public:
+    using Clock = std::chrono::steady_clock;
+
+private:
+    using StorePointer = std::shared_ptr<const ConfigStore>;
+
+    /**
+     * @brief The published data, which is never modified. Readers load it
+     * without taking mutex_, though the standard library may guard the atomic
+     * shared pointer with a small internal lock. nullptr while the data is
+     * spilled to spillPath_.
+     *
+     * Mutable since even const accessors reload spilled data.
+     */
+    mutable std::atomic<StorePointer> snapshot_;
+    /**
+     * @brief A copy of the snapshot with the changes made since it was
+     * published, or nullptr if there are none. Published once per frame, so
+     * that many changes in a row only copy the data once.
+     */
+    std::shared_ptr<ConfigStore> pendingStore_;
+    /**
+     * @brief Whether pendingStore_ is set. Lets readers skip the mutex when
+     * there are no pending changes.
+     */
+    std::atomic<bool> hasPendingChanges_ = false;
+    /**
+     * @brief The file the data was spilled to, while it's spilled.
+     */
+    mutable std::optional<std::filesystem::path> spillPath_;
+    /**
+     * @brief Serializes changes, publishing and spilling. Readers only lock it
+     * while there are pending changes.
+     */
+    mutable std::mutex mutex_;
+
+    /**
+     * @brief The name of the script that opened or created the configuration.
+     */
+    const std::string owner_;
+    std::atomic<Clock::rep> lastAccess_;
+
+    /**
+     * @brief Incremented on every change to the data. Guarded by mutex_, like
+     * the saved version and path.
+     */
+    std::uint64_t version_ = 0;
+    /**
+     * @brief The version last confirmed written to savedPath_.
+     */
+    std::uint64_t savedVersion_ = 0;
+    /**
+     * @brief The path the data was read from or last confirmed written to.
+     */
+    std::optional<std::filesystem::path> savedPath_;
+
+    /**
+     * @brief Returns the snapshot, reading it back from the spill file first
+     * if needed. Call with the mutex locked.
+     */
+    StorePointer reload_() const;
+
+    /**
+     * @brief Returns the published snapshot, reading it back from the spill
+     * file first if needed.
+     */
+    StorePointer loadSnapshot_() const
+    {
+        auto snapshot = snapshot_.load();
+
+        if (snapshot == nullptr) {
+            std::lock_guard lock(mutex_);
+            snapshot = reload_();
+        }
+
+        return snapshot;
+    }
+
+    /**
+     * @brief Returns the latest version of the data. Call with the mutex
+     * locked.
+     */
+    const ConfigStore& currentStore_() const
+    {
+        if (pendingStore_ != nullptr) {
+            return *pendingStore_;
+        }
+
+        return *reload_();
+    }
+
+    /**
+     * @brief Returns the store to apply changes to, copying the snapshot first
+     * if there are no pending changes yet. Call with the mutex locked.
+     */
+    ConfigStore& mutableStore_();
+
+    /**
+     * @brief Publishes the pending changes, if any. Call with the mutex locked.
+     */
+    void publish_();
+
+    /**
+     * @brief Calls find(store) on the latest version of the data: the pending
+     * changes while there are any, and the snapshot otherwise.
+     *
+     * @details The pending store has to be searched first, since a pending
+     * change may replace a value that is also in the snapshot.
+     *
+     * @param[in] find A function returning a std::optional.
+     */
+    template <typename Find>
+    auto find_(Find&& find) const
+    {
+        if (hasPendingChanges_.load()) {
+            std::lock_guard lock(mutex_);
+            return find(currentStore_());
+        }
+
+        // Publishing stores the new snapshot before clearing the flag, so if
+        // there are no pending changes now, the snapshot loaded next has all
+        // of them.
+        return find(*loadSnapshot_());
+    }
+
+    /**
+     * @brief Returns the value at the given key in the store, or std::nullopt
+     * if it doesn't exist or has an incompatible type.
+     *
+     * @param[in] key The full key.
+     * @param[in] segments The key split into its path segments.
+     */
+    template <typename T>
+    static std::optional<T> findIn_(
+        const ConfigStore& store,
+        const std::string_view key,
+        const PathSegments segments)
+    {
+        if constexpr (std::is_integral_v<T>) {
+            const auto value = store.getInt(key, segments);
+
+            if (!value.has_value() ||
+                *value < std::numeric_limits<T>::min() ||
+                *value > std::numeric_limits<T>::max()) {
+                return std::nullopt;
+            }
+
+            return static_cast<T>(*value);
+        } else {
+            const auto value = store.getFloat(key, segments);
+
+            if (!value.has_value()) {
+                return std::nullopt;
+            }
+
+            return static_cast<T>(*value);
+        }
+    }
+
+    /**
+     * @brief Returns the value at the given key, or defaultValue if it doesn't
+     * exist or has an incompatible type.
+     */
+    template <typename T>
+    T valueOr_(
+        const std::string_view key,
+        const PathSegments segments,
+        const T& defaultValue) const
+    {
+        return find_([&](const ConfigStore& store) {
+                   return findIn_<T>(store, key, segments);
+               })
+            .value_or(defaultValue);
+    }
+
+    template <typename T>
+    T valueOr_(const std::string_view key, const T& defaultValue) const
+    {
+        return withPathSegments(key, [&, this](const PathSegments segments) {
+            return valueOr_(key, segments, defaultValue);
+        });
+    }
+
+    bool has_(const std::string_view key, const PathSegments segments) const
+    {
+        return find_([&](const ConfigStore& store) {
+                   return store.has(key, segments) ? std::optional(true)
+                                                   : std::nullopt;
+               })
+            .has_value();
+    }
+
+    bool has_(const std::string_view key) const
+    {
+        return withPathSegments(key, [&, this](const PathSegments segments) {
+            return has_(key, segments);
+        });
+    }
+
+    /**
+     * @brief Inserts the value if the key doesn't exist yet. Call with the
+     * mutex locked.
+     *
+     * @throws std::invalid_argument The key can't be stored (e.g. a segment
+     * along its path exists but isn't a table).
+     */
+    template <typename T>
+    void insert_(
+        const std::string_view key,
+        const PathSegments segments,
+        const T value)
+    {
+        // Existing values are never replaced, so avoid copying the snapshot
+        // when nothing would change.
+        if (currentStore_().has(key, segments)) {
+            return;
+        }
+
+        ConfigValue storedValue;
+
+        if constexpr (std::is_integral_v<T>) {
+            storedValue = static_cast<std::int64_t>(value);
+        } else {
+            storedValue = static_cast<double>(value);
+        }
+
+        if (mutableStore_().insert(key, segments, storedValue)) {
+            ++version_;
+        }
+    }
+
+    template <typename T>
+    void insert_(const std::string_view key, const T value)
+    {
+        withPathSegments(key, [&, this](const PathSegments segments) {
+            insert_(key, segments, value);
+        });
+    }
+
+    /**
+     * @brief Sets multiple values. Does not lock the mutex.
+     */
+    template <typename T, typename KeyList>
+    void setAll_(const KeyList& keys, const std::vector<T>& values)
+    {
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            insert_(std::string_view(keys[i]), values[i]);
+        }
+    }
+
+public:
+    struct SaveData {
+        std::string contents;
+        /**
+         * @brief The version of the data in contents. Pass it to markSaved()
+         * once the contents are written.
+         */
+        std::uint64_t version;
+    };
+
+    /**
+     * @param[in] owner The name of the script creating the configuration.
+     */
+    explicit Config(std::string_view owner);
+    /**
+     * @param[in] path The file to read the configuration from.
+     * @param[in] owner The name of the script opening the configuration.
+     */
+    explicit Config(const std::filesystem::path& path, std::string_view owner);
+    ~Config();
+
+    Config(const Config&) = delete;
+    Config(Config&&) = delete;
+    Config& operator=(const Config&) = delete;
+    Config& operator=(Config&&) = delete;
+
+    const std::string& owner() const noexcept { return owner_; }
+
+    /**
+     * @brief Records that the configuration was just used.
+     */
+    void touch() noexcept
+    {
+        lastAccess_.store(
+            Clock::now().time_since_epoch().count(),
+            std::memory_order_relaxed);
+    }
+
+    Clock::time_point lastAccess() const noexcept
+    {
+        return Clock::time_point(
+            Clock::duration(lastAccess_.load(std::memory_order_relaxed)));
+    }
+
+    bool isSpilled() const
+    {
+        std::lock_guard lock(mutex_);
+        return pendingStore_ == nullptr && snapshot_.load() == nullptr;
+    }
+
+    /**
+     * @brief Returns a rough estimate of the memory used by the data, in
+     * bytes, or 0 if it's spilled.
+     */
+    std::size_t estimateMemoryUsage() const;
+
+    /**
+     * @brief Publishes the pending changes, if any, so that readers no longer
+     * need to lock anything to see them. Called once per frame while changes
+     * are pending.
+     */
+    void publish();
+
+    /**
+     * @brief Writes the data to a spill file and releases it. The data is read
+     * back the next time it's accessed.
+     *
+     * @param[in] spillPathStem The path to spill to, without the extension.
+     * @returns False if the data was already spilled.
+     * @throws std::runtime_error The spill file could not be written. The data
+     * is kept in memory.
+     */
+    bool spill(const std::filesystem::path& spillPathStem);
+
+    // Keys may be dotted paths (e.g. "section.sub.key") referring to entries
+    // in nested tables. Setting a path creates the tables along it as needed.
+    // Binary configurations store the full dotted path as a flat key.
+
+    bool has(const std::string_view key) const { return has_(key); }
+
+    bool has(const ConfigPath& path) const
+    {
+        return has_(path.str(), path.segments());
+    }
+
+    template <typename T>
+    T get(const std::string_view key, const T& defaultValue) const
+    {
+        return valueOr_(key, defaultValue);
+    }
+
+    template <typename T>
+    T get(const ConfigPath& path, const T& defaultValue) const
+    {
+        return valueOr_(path.str(), path.segments(), defaultValue);
+    }
+
+    template <typename T>
+    void set(const std::string_view key, const T value)
+    {
+        std::lock_guard lock(mutex_);
+
+        insert_(key, value);
+    }
+
+    template <typename T>
+    void set(const ConfigPath& path, const T value)
+    {
+        std::lock_guard lock(mutex_);
+
+        insert_(path.str(), path.segments(), value);
+    }
+
+    /**
+     * @brief Looks up multiple keys. keys and defaultValues must have the same
+     * size.
+     */
+    template <typename T, typename KeyList>
+    std::vector<T> getAll(
+        const KeyList& keys,
+        const std::vector<T>& defaultValues) const
+    {
+        std::vector<T> values;
+        values.reserve(keys.size());
+
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            values.push_back(
+                valueOr_(std::string_view(keys[i]), defaultValues[i]));
+        }
+
+        return values;
+    }
+
+    /**
+     * @brief Checks multiple keys.
+     *
+     * @returns 1 for every key that exists, 0 otherwise.
+     */
+    template <typename KeyList>
+    std::vector<int> hasAll(const KeyList& keys) const
+    {
+        std::vector<int> results;
+        results.reserve(keys.size());
+
+        for (const auto& key : keys) {
+            results.push_back(has_(std::string_view(key)));
+        }
+
+        return results;
+    }
+
+    /**
+     * @brief Sets multiple values under a single lock. keys and values must
+     * have the same size.
+     */
+    template <typename T, typename KeyList>
+    void setAll(const KeyList& keys, const std::vector<T>& values)
+    {
+        std::lock_guard lock(mutex_);
+
+        setAll_(keys, values);
+    }
+
+    /**
+     * @brief Sets multiple values of two different types under a single lock.
+     */
+    template <typename T, typename U, typename KeyList>
+    void setAll(
+        const KeyList& keysT,
+        const std::vector<T>& valuesT,
+        const KeyList& keysU,
+        const std::vector<U>& valuesU)
+    {
+        std::lock_guard lock(mutex_);
+
+        setAll_(keysT, valuesT);
+        setAll_(keysU, valuesU);
+    }
+
+    /**
+     * @brief Serializes the data in the format matching the extension of the
+     * given path.
+     *
+     * @details If the contents replace the file the snapshot reads from,
+     * rather than add to it, the snapshot is swapped for one that no longer
+     * keeps the file open.
+     *
+     * @returns std::nullopt if the data hasn't changed since it was read from
+     * the file or last confirmed written to it, and the file still exists.
+     */
+    std::optional<SaveData>
+        serializeForSave(const std::filesystem::path& filePath);
+
+    /**
+     * @brief Records that the given version of the data was written to the
+     * file. Only call this once the write is confirmed, so that the next save
+     * retries a failed one.
+     */
+    void markSaved(
+        const std::filesystem::path& filePath,
+        std::uint64_t version);
+};
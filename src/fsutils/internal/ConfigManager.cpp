@@ -1,80 +1,290 @@
-#include "ConfigManager.hpp"
-
-#include <filesystem>
-
-#include "../../utilities/containerutils.hpp"
-
-// Note to Future Me: Do not handle exceptions here. Let them propagate to the
-//                    actual Papyrus call so that we have access to the
-//                    Papyrus VM context for logging.
-
-using HandleType = ConfigManager::HandleType;
-
-HandleType ConfigManager::openConfig(const std::filesystem::path& filePath)
-{
-    std::unique_lock lock(mutex_);
-
-    // Do NOT use the public function otherwise we'll end up in a deadlock.
-    const auto handle = getNextHandle_();
-    configs_.emplace(handle, filePath.string());
-    return handle;
-}
-
-HandleType ConfigManager::createConfig()
-{
-    std::unique_lock lock(mutex_);
-
-    // Do NOT use the public function otherwise we'll end up in a deadlock.
-    const auto handle = getNextHandle_();
-    configs_.emplace(
-        std::piecewise_construct,
-        std::forward_as_tuple(handle),
-        std::tuple<>());
-
-    return handle;
-}
-
-void ConfigManager::closeConfig(const HandleType handle)
-{
-    std::unique_lock lock(mutex_);
-
-    configs_.erase(handle);
-}
-
-bool ConfigManager::saveConfig(
-    const HandleType handle,
-    const std::filesystem::path& filePath) const
-{
-    std::shared_lock lock(mutex_);
-
-    auto it = configs_.find(handle);
-
-    if (it == configs_.end()) {
-        // Handle does not exist.
-        return false;
-    }
-
-    const auto& config = it->second;
-    config.writeToDisk(filePath);
-    return true;
-}
-
-std::optional<std::reference_wrapper<Config>>
-    ConfigManager::getConfig(const HandleType handle)
-{
-    std::shared_lock lock(mutex_);
-
-    auto it = configs_.find(handle);
-
-    if (it == configs_.end()) {
-        return std::nullopt;
-    }
-
-    return it->second;
-}
-
-void ConfigManager::closeAllConfigs()
-{
-    std::unique_lock handle(mutex_);
-    clearContainer(configs_);
-}
+#include "ConfigManager.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include "ConfigStore.hpp"
+#include "ConfigWriter.hpp"
+#include "IoExecutor.hpp"
+#include "../../global.hpp"
+
+// Note to Future Me: Do not handle exceptions here. Let them propagate to the
+//                    actual Papyrus call so that we have access to the
+//                    Papyrus VM context for logging.
+
+using namespace std::literals;
+
+using HandleType = ConfigManager::HandleType;
+
+namespace {
+    const std::filesystem::path SpillDirectory_(
+        "Data/SKSE/Plugins/YASTMFSUtils/Spill");
+
+    std::filesystem::path getSpillPathStem_(const HandleType handle)
+    {
+        return SpillDirectory_ / std::to_string(handle);
+    }
+} // namespace
+
+HandleType ConfigManager::openConfig(
+    const std::filesystem::path& filePath,
+    const std::string_view owner)
+{
+    // Make sure we read the latest saved contents.
+    ConfigWriter::getInstance().flush(filePath);
+
+    // Parse the file before taking a handle so that a failed parse doesn't
+    // use one up.
+    const auto handle =
+        configs_.insert(std::make_shared<Config>(filePath, owner));
+
+    queueBudgetCheck_();
+
+    return handle;
+}
+
+HandleType ConfigManager::createConfig(const std::string_view owner)
+{
+    const auto handle = configs_.insert(std::make_shared<Config>(owner));
+
+    queueBudgetCheck_();
+
+    return handle;
+}
+
+void ConfigManager::closeConfig(const HandleType handle)
+{
+    configs_.erase(handle);
+}
+
+bool ConfigManager::saveConfig(
+    const HandleType handle,
+    const std::filesystem::path& filePath,
+    ConfigWriter::WriteCallback onWritten) const
+{
+    const auto config = getConfig(handle);
+
+    if (config == nullptr) {
+        // Handle does not exist.
+        return false;
+    }
+
+    auto saveData = config->serializeForSave(filePath);
+
+    if (!saveData.has_value()) {
+        // Nothing changed since the file was read or written.
+        if (onWritten != nullptr) {
+            onWritten(true);
+        }
+
+        return true;
+    }
+
+    // Only serialize here. The file is written in the background, since MCM
+    // scripts may save on every change.
+    ConfigWriter::getInstance().enqueue(
+        filePath,
+        std::move(saveData->contents),
+        [weakConfig = std::weak_ptr(config),
+         filePath,
+         version = saveData->version,
+         onWritten = std::move(onWritten)](const bool isWritten) {
+            if (const auto savedConfig = weakConfig.lock();
+                isWritten && savedConfig != nullptr) {
+                savedConfig->markSaved(filePath, version);
+            }
+
+            if (onWritten != nullptr) {
+                onWritten(isWritten);
+            }
+        });
+
+    return true;
+}
+
+void ConfigManager::closeAllConfigs() { configs_.clear(); }
+
+std::size_t ConfigManager::convertConfig(
+    const std::filesystem::path& sourcePath,
+    const std::filesystem::path& destinationPath,
+    ConfigWriter::WriteCallback onWritten) const
+{
+    ConfigWriter::getInstance().flush(sourcePath);
+
+    const auto store = openConfigStore(sourcePath);
+
+    std::size_t skippedCount = 0;
+    auto contents =
+        serializeAs(*store, getConfigFormat(destinationPath), skippedCount);
+
+    ConfigWriter::getInstance().enqueue(
+        destinationPath,
+        std::move(contents),
+        std::move(onWritten));
+
+    return skippedCount;
+}
+
+void ConfigManager::setMemoryBudget(
+    const std::size_t budget,
+    const std::chrono::seconds minIdleTime)
+{
+    memoryBudget_.store(budget, std::memory_order_relaxed);
+    minIdleTime_.store(minIdleTime.count(), std::memory_order_relaxed);
+
+    queueBudgetCheck_();
+}
+
+void ConfigManager::queueBudgetCheck_() const
+{
+    if (memoryBudget_.load(std::memory_order_relaxed) == 0 ||
+        isBudgetCheckQueued_.exchange(true)) {
+        return;
+    }
+
+    nextBudgetCheck_.store(
+        (Config::Clock::now() + BudgetCheckInterval).time_since_epoch().count(),
+        std::memory_order_relaxed);
+
+    // Estimating and spilling can take a while for large configurations, so
+    // keep it off the calling script's thread.
+    getIoExecutor()->submit([this] {
+        isBudgetCheckQueued_.store(false);
+        enforceMemoryBudget();
+    });
+}
+
+void ConfigManager::queueBudgetCheckIfDue_() const
+{
+    const auto now = Config::Clock::now().time_since_epoch().count();
+
+    if (now >= nextBudgetCheck_.load(std::memory_order_relaxed)) {
+        queueBudgetCheck_();
+    }
+}
+
+void ConfigManager::enforceMemoryBudget() const
+{
+    const auto budget = memoryBudget_.load(std::memory_order_relaxed);
+
+    if (budget == 0) {
+        return;
+    }
+
+    struct Candidate {
+        HandleType handle;
+        std::shared_ptr<Config> config;
+        std::size_t memoryUsage;
+        Config::Clock::time_point lastAccess;
+    };
+
+    std::vector<Candidate> candidates;
+
+    configs_.forEach([&](const HandleType handle, const auto& config) {
+        candidates.push_back(
+            Candidate{handle, config, 0, config->lastAccess()});
+    });
+
+    // Estimate outside forEach() so that the table isn't locked meanwhile.
+    std::size_t totalMemoryUsage = 0;
+
+    for (auto& candidate : candidates) {
+        candidate.memoryUsage = candidate.config->estimateMemoryUsage();
+        totalMemoryUsage += candidate.memoryUsage;
+    }
+
+    if (totalMemoryUsage <= budget) {
+        return;
+    }
+
+    std::ranges::sort(candidates, {}, &Candidate::lastAccess);
+
+    const auto idleThreshold =
+        Config::Clock::now() -
+        std::chrono::seconds(minIdleTime_.load(std::memory_order_relaxed));
+
+    for (const auto& candidate : candidates) {
+        // Candidates are sorted by last access, so the rest are too recent.
+        if (totalMemoryUsage <= budget ||
+            candidate.lastAccess > idleThreshold) {
+            break;
+        }
+
+        try {
+            if (candidate.config->spill(getSpillPathStem_(candidate.handle))) {
+                totalMemoryUsage -= candidate.memoryUsage;
+
+                LOG_INFO_FMT(
+                    "Spilled idle configuration {} (opened by {}) to disk, "
+                    "freeing about {} bytes."sv,
+                    candidate.handle,
+                    candidate.config->owner(),
+                    candidate.memoryUsage);
+            }
+        } catch (const std::exception& error) {
+            LOG_ERROR_FMT(
+                "Could not spill configuration {}: {}"sv,
+                candidate.handle,
+                error.what());
+        }
+    }
+}
+
+void ConfigManager::clearSpillDirectory()
+{
+    std::error_code error;
+    const auto removedCount =
+        std::filesystem::remove_all(SpillDirectory_, error);
+
+    if (error) {
+        LOG_WARN_FMT(
+            "Could not clear spill directory \"{}\": {}"sv,
+            SpillDirectory_.string(),
+            error.message());
+    } else if (removedCount > 0) {
+        LOG_INFO_FMT("Removed {} leftover spill entries."sv, removedCount);
+    }
+}
+
+std::vector<ConfigManager::HandleInfo> ConfigManager::listHandles() const
+{
+    std::vector<std::pair<HandleType, std::shared_ptr<Config>>> configs;
+
+    configs_.forEach([&](const HandleType handle, const auto& config) {
+        configs.emplace_back(handle, config);
+    });
+
+    const auto now = Config::Clock::now();
+
+    std::vector<HandleInfo> handles;
+    handles.reserve(configs.size());
+
+    for (const auto& [handle, config] : configs) {
+        handles.push_back(HandleInfo{
+            handle,
+            config->owner(),
+            config->estimateMemoryUsage(),
+            std::chrono::duration_cast<std::chrono::seconds>(
+                now - config->lastAccess()),
+            config->isSpilled(),
+        });
+    }
+
+    return handles;
+}
+
+HandleType ConfigManager::getLargestHandle() const
+{
+    HandleType largestHandle = 0;
+
+    configs_.forEach([&](const HandleType handle, const auto&) {
+        largestHandle = std::max(largestHandle, handle);
+    });
+
+    return largestHandle;
+}
@@ -1,94 +1,172 @@
-#pragma once
-
-#include <map>
-#include <shared_mutex>
-#include <optional>
-
-#include "Config.hpp"
-
-namespace std {
-    namespace filesystem {
-        class path;
-    }
-} // namespace std
-
-class ConfigManager {
-public:
-    using HandleType = int;
-
-private:
-    explicit ConfigManager() {}
-    ConfigManager(const ConfigManager&) = delete;
-    ConfigManager(ConfigManager&&) = delete;
-    ConfigManager& operator=(const ConfigManager&) = delete;
-    ConfigManager& operator=(ConfigManager&) = delete;
-
-    std::map<HandleType, Config> configs_;
-    mutable std::shared_mutex mutex_;
-
-    /**
-     * Returns the largest handle that currently exists. Or 0 if there are no
-     * handles.
-     *
-     * Does not lock mutex. All internal users should use this instead of the
-     * public version.
-     */
-    HandleType getLargestHandle_() const noexcept
-    {
-        const auto largestKey = configs_.rbegin();
-
-        if (largestKey != configs_.rend()) {
-            return largestKey->first;
-        }
-
-        return 0;
-    }
-
-    /**
-     * Returns the value of the next handle that will be created.
-     *
-     * Does not lock mutex. All internal users should use this instead of the
-     * public version.
-     */
-    HandleType getNextHandle_() const noexcept
-    {
-        return getLargestHandle_() + 1;
-    }
-
-public:
-    static ConfigManager& getInstance()
-    {
-        static ConfigManager instance;
-        return instance;
-    }
-
-    HandleType openConfig(const std::filesystem::path& path);
-    HandleType createConfig();
-
-    void closeConfig(HandleType handle);
-    bool saveConfig(HandleType handle, const std::filesystem::path& path) const;
-    void closeAllConfigs();
-
-    std::size_t size() const noexcept { return configs_.size(); }
-
-    /**
-     * Returns the largest handle that currently exists. Or 0 if there are no
-     * handles.
-     */
-    HandleType getLargestHandle() const
-    {
-        std::shared_lock lock(mutex_);
-        return getLargestHandle_();
-    }
-
-    /**
-     * Returns the value of the next handle that will be created.
-     */
-    HandleType getNextHandle() const
-    {
-        std::shared_lock lock(mutex_);
-        return getNextHandle_();
-    }
-
-    std::optional<std::reference_wrapper<Config>> getConfig(HandleType handle);
-};
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <cstddef>
+
+#include "Config.hpp"
+#include "ConfigWriter.hpp"
+#include "HandleTable.hpp"
+
+class ConfigManager {
+public:
+    using ConfigTable = HandleTable<Config>;
+    using HandleType = ConfigTable::HandleType;
+
+    struct HandleInfo {
+        HandleType handle;
+        std::string owner;
+        /**
+         * @brief Estimated memory used by the data, or 0 if it's spilled.
+         */
+        std::size_t memoryUsage;
+        std::chrono::seconds idleTime;
+        bool isSpilled;
+    };
+
+    static constexpr std::size_t DefaultMemoryBudget = 16 * 1024 * 1024;
+    static constexpr std::chrono::seconds DefaultMinIdleTime{300};
+    /**
+     * @brief How often accessing a configuration queues a memory budget check.
+     */
+    static constexpr std::chrono::seconds BudgetCheckInterval{30};
+
+private:
+    explicit ConfigManager() {}
+    ConfigManager(const ConfigManager&) = delete;
+    ConfigManager(ConfigManager&&) = delete;
+    ConfigManager& operator=(const ConfigManager&) = delete;
+    ConfigManager& operator=(ConfigManager&) = delete;
+
+    ConfigTable configs_;
+
+    std::atomic<std::size_t> memoryBudget_ = DefaultMemoryBudget;
+    std::atomic<std::chrono::seconds::rep> minIdleTime_ =
+        DefaultMinIdleTime.count();
+    mutable std::atomic<bool> isBudgetCheckQueued_ = false;
+    mutable std::atomic<Config::Clock::rep> nextBudgetCheck_ = 0;
+
+    /**
+     * @brief Queues a memory budget check on the I/O executor, unless one is
+     * already queued.
+     */
+    void queueBudgetCheck_() const;
+    /**
+     * @brief Queues a memory budget check if the last one was queued at least
+     * BudgetCheckInterval ago. Configurations only become idle over time, so
+     * checking when they're opened isn't enough.
+     */
+    void queueBudgetCheckIfDue_() const;
+
+public:
+    static ConfigManager& getInstance()
+    {
+        static ConfigManager instance;
+        return instance;
+    }
+
+    /**
+     * @param[in] owner The name of the script opening the configuration.
+     */
+    HandleType
+        openConfig(const std::filesystem::path& path, std::string_view owner);
+    /**
+     * @param[in] owner The name of the script creating the configuration.
+     */
+    HandleType createConfig(std::string_view owner);
+
+    void closeConfig(HandleType handle);
+    /**
+     * Queues the configuration to be written to the given path, unless it
+     * hasn't changed since it was read from or last written to that path.
+     *
+     * @param[in] onWritten Called on the writer thread once the file is
+     * written, or right away if there's nothing to write. Not called if the
+     * handle doesn't exist.
+     *
+     * @returns false if the handle doesn't exist.
+     */
+    bool saveConfig(
+        HandleType handle,
+        const std::filesystem::path& path,
+        ConfigWriter::WriteCallback onWritten = nullptr) const;
+    void closeAllConfigs();
+
+    /**
+     * Writes the contents of the source file to the destination file, in the
+     * format matching the destination's extension.
+     *
+     * @param[in] onWritten Called on the writer thread once the destination is
+     * written.
+     *
+     * @returns The number of entries that couldn't be converted and were left
+     * out.
+     */
+    std::size_t convertConfig(
+        const std::filesystem::path& sourcePath,
+        const std::filesystem::path& destinationPath,
+        ConfigWriter::WriteCallback onWritten = nullptr) const;
+
+    std::size_t size() const noexcept { return configs_.size(); }
+
+    /**
+     * Returns the largest handle that currently exists. Or 0 if there are no
+     * handles.
+     */
+    HandleType getLargestHandle() const;
+
+    /**
+     * Returns the value of the next handle that will be created.
+     */
+    HandleType getNextHandle() const { return configs_.peekNextHandle(); }
+
+    /**
+     * Returns the configuration with the given handle, or nullptr if the handle
+     * is not valid. The configuration stays alive while the returned pointer
+     * is held, even if the handle is closed in the meantime.
+     */
+    std::shared_ptr<Config> getConfig(HandleType handle) const
+    {
+        auto config = configs_.get(handle);
+
+        if (config != nullptr) {
+            config->touch();
+            queueBudgetCheckIfDue_();
+        }
+
+        return config;
+    }
+
+    /**
+     * Sets the memory budget for open configurations. Once their estimated
+     * total exceeds the budget, the least recently used configurations that
+     * have been idle for at least minIdleTime are spilled to disk until the
+     * total fits again. Spilled configurations are read back when next used.
+     *
+     * A budget of 0 disables spilling.
+     */
+    void setMemoryBudget(std::size_t budget, std::chrono::seconds minIdleTime);
+
+    /**
+     * Spills idle configurations until the open configurations fit in the
+     * memory budget (or no idle configurations are left).
+     */
+    void enforceMemoryBudget() const;
+
+    /**
+     * Removes the files left in the spill directory by a previous session.
+     * Call this at plugin load time, before any configuration is spilled.
+     */
+    static void clearSpillDirectory();
+
+    /**
+     * Returns information about every open handle, for debugging.
+     */
+    std::vector<HandleInfo> listHandles() const;
+};
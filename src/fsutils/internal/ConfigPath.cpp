@@ -0,0 +1,40 @@
+#include "ConfigPath.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+ConfigPath::ConfigPath(const std::string_view path)
+    : path_(path)
+{
+    // Split the stored copy so that the segments point into it.
+    auto segments = trySplit(path_);
+
+    if (!segments.has_value()) {
+        throw std::invalid_argument("Key path \"" + path_ + "\" is invalid");
+    }
+
+    segments_ = std::move(*segments);
+}
+
+std::optional<std::vector<std::string_view>>
+    ConfigPath::trySplit(std::string_view path)
+{
+    std::vector<std::string_view> segments;
+
+    while (true) {
+        const auto separator = path.find('.');
+        const auto segment = path.substr(0, separator);
+
+        if (segment.empty()) {
+            return std::nullopt;
+        }
+
+        segments.push_back(segment);
+
+        if (separator == std::string_view::npos) {
+            return segments;
+        }
+
+        path.remove_prefix(separator + 1);
+    }
+}
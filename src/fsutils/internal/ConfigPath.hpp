@@ -0,0 +1,47 @@
+#pragma once
+
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief The segments of a key path, as views into the full path.
+ */
+using PathSegments = std::span<const std::string_view>;
+
+/**
+ * @brief A dotted key path (e.g. "section.sub.key") split into its segments.
+ *
+ * @details The segments point into the stored path, so a ConfigPath can't be
+ * copied or moved.
+ */
+class ConfigPath {
+    const std::string path_;
+    std::vector<std::string_view> segments_;
+
+public:
+    /**
+     * @throws std::invalid_argument The path is empty or has an empty
+     * segment.
+     */
+    explicit ConfigPath(std::string_view path);
+
+    ConfigPath(const ConfigPath&) = delete;
+    ConfigPath(ConfigPath&&) = delete;
+    ConfigPath& operator=(const ConfigPath&) = delete;
+    ConfigPath& operator=(ConfigPath&&) = delete;
+
+    const std::string& str() const noexcept { return path_; }
+    PathSegments segments() const noexcept { return segments_; }
+
+    /**
+     * @brief Splits the path into views of its segments.
+     *
+     * @returns The segments, or std::nullopt if the path is empty or has an
+     * empty segment.
+     */
+    static std::optional<std::vector<std::string_view>>
+        trySplit(std::string_view path);
+};
@@ -0,0 +1,50 @@
+#include "ConfigPathRegistry.hpp"
+
+#include <mutex>
+#include <stdexcept>
+
+ConfigPathRegistry::IdType
+    ConfigPathRegistry::compile(const std::string_view path)
+{
+    const std::string pathStr(path);
+
+    {
+        std::shared_lock lock(mutex_);
+
+        if (const auto it = pathToIdMap_.find(pathStr);
+            it != pathToIdMap_.end()) {
+            return it->second;
+        }
+    }
+
+    // Validate the path before taking the exclusive lock.
+    if (!ConfigPath::trySplit(path).has_value()) {
+        throw std::invalid_argument("Key path \"" + pathStr + "\" is invalid");
+    }
+
+    std::unique_lock lock(mutex_);
+
+    // Another thread may have compiled the same path in the meantime.
+    if (const auto it = pathToIdMap_.find(pathStr); it != pathToIdMap_.end()) {
+        return it->second;
+    }
+
+    // ConfigPath can't be moved, so construct it in place.
+    paths_.emplace_back(path);
+
+    const auto id = static_cast<IdType>(paths_.size());
+    pathToIdMap_.emplace(pathStr, id);
+
+    return id;
+}
+
+const ConfigPath* ConfigPathRegistry::get(const IdType id) const
+{
+    std::shared_lock lock(mutex_);
+
+    if (id <= 0 || static_cast<std::size_t>(id) > paths_.size()) {
+        return nullptr;
+    }
+
+    return &paths_[static_cast<std::size_t>(id) - 1];
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "ConfigPath.hpp"
+
+/**
+ * @brief Stores key paths compiled by scripts so that they can be referred to
+ * by an integer ID.
+ *
+ * @details Compiling the same path twice returns the same ID. Compiled paths
+ * are never removed, so an ID stays valid until the game exits.
+ */
+class ConfigPathRegistry {
+public:
+    using IdType = int;
+
+private:
+    // std::deque never moves its elements, so pointers returned by get() stay
+    // valid while other paths are compiled.
+    std::deque<ConfigPath> paths_;
+    std::unordered_map<std::string, IdType> pathToIdMap_;
+    mutable std::shared_mutex mutex_;
+
+    explicit ConfigPathRegistry() = default;
+
+public:
+    ConfigPathRegistry(const ConfigPathRegistry&) = delete;
+    ConfigPathRegistry(ConfigPathRegistry&&) = delete;
+    ConfigPathRegistry& operator=(const ConfigPathRegistry&) = delete;
+    ConfigPathRegistry& operator=(ConfigPathRegistry&&) = delete;
+
+    static ConfigPathRegistry& getInstance()
+    {
+        static ConfigPathRegistry instance;
+        return instance;
+    }
+
+    /**
+     * @brief Returns the ID of the given path, compiling it if needed. IDs are
+     * positive.
+     *
+     * @throws std::invalid_argument The path is invalid.
+     */
+    IdType compile(std::string_view path);
+
+    /**
+     * @brief Returns the path with the given ID, or nullptr if there is none.
+     */
+    const ConfigPath* get(IdType id) const;
+};
@@ -0,0 +1,74 @@
+#include "ConfigStore.hpp"
+
+#include <string>
+
+#include "../../utilities/stringutils.hpp"
+#include "BinaryConfigStore.hpp"
+#include "TomlConfigStore.hpp"
+
+// Note to Future Me: Do not handle exceptions here. Let them propagate to the
+//                    actual Papyrus call so that we have access to the
+//                    Papyrus VM context for logging.
+
+ConfigFormat getConfigFormat(const std::filesystem::path& path)
+{
+    const auto extension = path.extension().string();
+
+    if (getLowerString(extension) == getFileExtension(ConfigFormat::Binary)) {
+        return ConfigFormat::Binary;
+    }
+
+    return ConfigFormat::Toml;
+}
+
+std::string_view getFileExtension(const ConfigFormat format) noexcept
+{
+    using namespace std::literals;
+
+    switch (format) {
+    case ConfigFormat::Binary:
+        return ".ykv"sv;
+    case ConfigFormat::Toml:
+    default:
+        return ".toml"sv;
+    }
+}
+
+std::unique_ptr<ConfigStore> createConfigStore(const ConfigFormat format)
+{
+    switch (format) {
+    case ConfigFormat::Binary:
+        return std::make_unique<BinaryConfigStore>();
+    case ConfigFormat::Toml:
+    default:
+        return std::make_unique<TomlConfigStore>();
+    }
+}
+
+std::unique_ptr<ConfigStore> openConfigStore(const std::filesystem::path& path)
+{
+    switch (getConfigFormat(path)) {
+    case ConfigFormat::Binary:
+        return std::make_unique<BinaryConfigStore>(path);
+    case ConfigFormat::Toml:
+    default:
+        return std::make_unique<TomlConfigStore>(path);
+    }
+}
+
+std::string serializeAs(
+    const ConfigStore& store,
+    const ConfigFormat format,
+    std::size_t& skippedCount)
+{
+    const auto target = createConfigStore(format);
+
+    skippedCount = store.forEachValue(
+        [&](const std::string_view key, const ConfigValue& value) {
+            withPathSegments(key, [&](const PathSegments segments) {
+                target->insert(key, segments, value);
+            });
+        });
+
+    return target->serialize();
+}
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <variant>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ConfigPath.hpp"
+
+/**
+ * @brief A value that can be stored in every configuration format.
+ */
+using ConfigValue = std::variant<std::int64_t, double>;
+
+enum class ConfigFormat {
+    Toml,
+    /**
+     * @brief The compact binary format of BinaryConfigStore.
+     */
+    Binary,
+};
+
+/**
+ * @brief Returns the format to use for the given file, based on its extension.
+ * Files ending in ".ykv" use the binary format. Everything else is TOML.
+ */
+ConfigFormat getConfigFormat(const std::filesystem::path& path);
+
+/**
+ * @brief Returns the file extension (including the dot) for the given format.
+ */
+std::string_view getFileExtension(ConfigFormat format) noexcept;
+
+/**
+ * @brief Stores the entries of a configuration in a specific format.
+ *
+ * @details Keys are passed both whole and split into their path segments, so
+ * that each store can use whichever it needs. Stores don't lock anything. The
+ * owning Config serializes access to them.
+ */
+class ConfigStore {
+public:
+    using ValueCallback =
+        std::function<void(std::string_view key, const ConfigValue& value)>;
+
+    virtual ~ConfigStore() {}
+
+    virtual ConfigFormat format() const noexcept = 0;
+
+    virtual bool has(std::string_view key, PathSegments segments) const = 0;
+    virtual std::optional<std::int64_t>
+        getInt(std::string_view key, PathSegments segments) const = 0;
+    virtual std::optional<double>
+        getFloat(std::string_view key, PathSegments segments) const = 0;
+
+    /**
+     * @brief Inserts the value if the key doesn't exist yet.
+     *
+     * @returns True if the value was inserted.
+     * @throws std::invalid_argument The key can't be stored (e.g. a segment
+     * along its path exists but isn't a table).
+     */
+    virtual bool insert(
+        std::string_view key,
+        PathSegments segments,
+        const ConfigValue& value) = 0;
+
+    /**
+     * @brief Calls fn for every int and float entry, with its full dotted key.
+     *
+     * @returns The number of entries skipped because they have a different
+     * type.
+     */
+    virtual std::size_t forEachValue(const ValueCallback& fn) const = 0;
+
+    /**
+     * @brief Returns a copy of the store. Data that neither store changes
+     * afterwards may be shared between them.
+     */
+    virtual std::unique_ptr<ConfigStore> clone() const = 0;
+
+    /**
+     * @brief Returns the file contents for this store.
+     */
+    virtual std::string serialize() const = 0;
+
+    /**
+     * @brief Returns a copy of the store that no longer keeps the file it was
+     * opened from open, if the serialized contents replace that file rather
+     * than add to it. Returns nullptr otherwise.
+     *
+     * @details Files that are still mapped can't be replaced on Windows.
+     *
+     * @param[in] contents What serialize() returned.
+     */
+    virtual std::unique_ptr<ConfigStore> releaseFile(const std::string&) const
+    {
+        return nullptr;
+    }
+
+    /**
+     * @brief Returns a rough estimate of the memory used by the store's data,
+     * in bytes.
+     */
+    virtual std::size_t estimateMemoryUsage() const = 0;
+};
+
+/**
+ * @brief Creates an empty store of the given format.
+ */
+std::unique_ptr<ConfigStore> createConfigStore(ConfigFormat format);
+
+/**
+ * @brief Opens the file with the store matching its extension.
+ */
+std::unique_ptr<ConfigStore> openConfigStore(const std::filesystem::path& path);
+
+/**
+ * @brief Returns the contents of the store converted to the given format.
+ *
+ * @param[out] skippedCount The number of entries that couldn't be converted.
+ */
+std::string serializeAs(
+    const ConfigStore& store,
+    ConfigFormat format,
+    std::size_t& skippedCount);
+
+/**
+ * @brief Calls fn with the segments of the key. Keys that aren't valid paths
+ * (e.g. with empty segments) are treated as a single top-level key.
+ */
+template <typename Fn>
+auto withPathSegments(const std::string_view key, Fn&& fn)
+{
+    if (key.find('.') != std::string_view::npos) {
+        if (const auto segments = ConfigPath::trySplit(key);
+            segments.has_value()) {
+            return fn(PathSegments(*segments));
+        }
+    }
+
+    return fn(PathSegments(&key, 1));
+}
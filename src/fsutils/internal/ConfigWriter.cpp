@@ -0,0 +1,230 @@
+#include "ConfigWriter.hpp"
+
+#include <fstream>
+#include <functional>
+#include <optional>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include "ConfigStore.hpp"
+#include "DirectoryIndex.hpp"
+#include "../../global.hpp"
+#include "../../utilities/stringutils.hpp"
+
+using namespace std::literals;
+
+ConfigWriter::ConfigWriter()
+    : worker_([this] { run_(); })
+{}
+
+ConfigWriter::~ConfigWriter()
+{
+    {
+        std::lock_guard lock(mutex_);
+        isStopping_ = true;
+    }
+
+    workAvailable_.notify_one();
+
+    // A running worker finishes the pending writes before it returns.
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+std::string ConfigWriter::toKey_(const std::filesystem::path& path)
+{
+    // Windows paths are case-insensitive.
+    return getLowerString(path.lexically_normal().string());
+}
+
+void ConfigWriter::enqueue(
+    const std::filesystem::path& path,
+    std::string contents,
+    WriteCallback onWritten)
+{
+    {
+        std::lock_guard lock(mutex_);
+
+        auto& write = pendingWrites_[toKey_(path)];
+        write.path = path;
+        write.contents = std::move(contents);
+
+        if (onWritten != nullptr) {
+            write.callbacks.push_back(std::move(onWritten));
+        }
+    }
+
+    workAvailable_.notify_one();
+}
+
+void ConfigWriter::recordContents(
+    const std::filesystem::path& path,
+    const std::string_view contents)
+{
+    const auto hash = std::hash<std::string_view>()(contents);
+
+    std::lock_guard lock(mutex_);
+
+    writtenFiles_.insert_or_assign(
+        toKey_(path),
+        WrittenFile{contents.size(), hash});
+}
+
+void ConfigWriter::flush(const std::filesystem::path& path)
+{
+    const auto key = toKey_(path);
+
+    std::unique_lock lock(mutex_);
+
+    writeFinished_.wait(lock, [&, this] {
+        return !pendingWrites_.contains(key) && !activeWrites_.contains(key);
+    });
+}
+
+void ConfigWriter::flushAll()
+{
+    std::unique_lock lock(mutex_);
+
+    writeFinished_.wait(lock, [this] {
+        return pendingWrites_.empty() && activeWrites_.empty();
+    });
+}
+
+void ConfigWriter::run_()
+{
+    std::unique_lock lock(mutex_);
+
+    while (true) {
+        workAvailable_.wait(lock, [this] {
+            return isStopping_ || !pendingWrites_.empty();
+        });
+
+        // Only stop once there is nothing left to write.
+        if (pendingWrites_.empty()) {
+            return;
+        }
+
+        auto node = pendingWrites_.extract(pendingWrites_.begin());
+        activeWrites_.insert(node.key());
+
+        lock.unlock();
+
+        const bool isWritten = write_(node.key(), node.mapped());
+
+        for (const auto& callback : node.mapped().callbacks) {
+            callback(isWritten);
+        }
+
+        lock.lock();
+
+        activeWrites_.erase(node.key());
+        writeFinished_.notify_all();
+    }
+}
+
+bool ConfigWriter::write_(const std::string& key, const PendingWrite& write)
+{
+    const std::string_view contents = write.contents;
+    const auto hash = std::hash<std::string_view>()(contents);
+    std::optional<WrittenFile> writtenFile;
+
+    {
+        std::lock_guard lock(mutex_);
+
+        if (const auto it = writtenFiles_.find(key);
+            it != writtenFiles_.end()) {
+            writtenFile = it->second;
+        }
+    }
+
+    if (writtenFile.has_value() && std::filesystem::exists(write.path)) {
+        if (writtenFile->size == contents.size() &&
+            writtenFile->hash == hash) {
+            LOG_TRACE_FMT(
+                "Skipping write to \"{}\". Contents are unchanged."sv,
+                write.path.string());
+            return true;
+        }
+
+        if (writtenFile->size < contents.size() &&
+            getConfigFormat(write.path) == ConfigFormat::Binary &&
+            std::hash<std::string_view>()(
+                contents.substr(0, writtenFile->size)) == writtenFile->hash &&
+            append_(write, writtenFile->size)) {
+            std::lock_guard lock(mutex_);
+            writtenFiles_.insert_or_assign(
+                key,
+                WrittenFile{contents.size(), hash});
+            return true;
+        }
+    }
+
+    auto tempPath = write.path;
+    tempPath += ".tmp"sv;
+
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        file << write.contents;
+
+        if (!file) {
+            LOG_ERROR_FMT(
+                "Could not write configuration file \"{}\"."sv,
+                tempPath.string());
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, write.path, error);
+
+    if (error) {
+        LOG_ERROR_FMT(
+            "Could not replace configuration file \"{}\": {}"sv,
+            write.path.string(),
+            error.message());
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+
+    // The index may have listed the directory before the file existed.
+    DirectoryIndex::getInstance().invalidate(write.path.parent_path());
+
+    std::lock_guard lock(mutex_);
+    writtenFiles_.insert_or_assign(key, WrittenFile{contents.size(), hash});
+
+    return true;
+}
+
+bool ConfigWriter::append_(const PendingWrite& write, const std::size_t offset)
+{
+    std::error_code error;
+
+    // Something else changed the file since it was last written.
+    if (std::filesystem::file_size(write.path, error) != offset || error) {
+        return false;
+    }
+
+    std::ofstream file(write.path, std::ios::binary | std::ios::app);
+    file.write(
+        write.contents.data() + offset,
+        static_cast<std::streamsize>(write.contents.size() - offset));
+
+    if (!file) {
+        // The partly appended records are dropped when the file is read, and
+        // the full rewrite that follows replaces them.
+        LOG_WARN_FMT(
+            "Could not append to configuration file \"{}\". Rewriting it "
+            "instead."sv,
+            write.path.string());
+        return false;
+    }
+
+    LOG_TRACE_FMT(
+        "Appended {} bytes to \"{}\"."sv,
+        write.contents.size() - offset,
+        write.path.string());
+
+    return true;
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <condition_variable>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <cstddef>
+
+/**
+ * @brief Writes configuration files on a background thread.
+ *
+ * @details Writes to the same path are coalesced: if a path is saved again
+ * before its previous write started, only the latest contents are written.
+ * Files are written to a temporary file first and then renamed over the
+ * target, so a crash never leaves a half-written configuration behind.
+ * Contents identical to what was last written to the same path are skipped.
+ *
+ * Binary configuration files whose new contents only add to what was last
+ * written or read (see recordContents()) are appended to instead. Their format tolerates a torn append,
+ * since readers drop incomplete log records at the end of the file.
+ */
+class ConfigWriter {
+public:
+    /**
+     * @brief Called on the writer thread once a queued write is finished.
+     * The argument is false if the file could not be written.
+     */
+    using WriteCallback = std::function<void(bool)>;
+
+private:
+    struct PendingWrite {
+        std::filesystem::path path;
+        std::string contents;
+        /**
+         * @brief Callbacks of this write and of the writes it replaced.
+         */
+        std::vector<WriteCallback> callbacks;
+    };
+
+    /**
+     * @brief Pending writes, keyed by normalized path.
+     */
+    std::unordered_map<std::string, PendingWrite> pendingWrites_;
+    /**
+     * @brief Paths currently being written by the worker thread.
+     */
+    std::unordered_set<std::string> activeWrites_;
+    struct WrittenFile {
+        std::size_t size;
+        std::size_t hash;
+    };
+
+    /**
+     * @brief Size and hash of the contents last written to each path.
+     */
+    std::unordered_map<std::string, WrittenFile> writtenFiles_;
+
+    std::mutex mutex_;
+    std::condition_variable workAvailable_;
+    std::condition_variable writeFinished_;
+    bool isStopping_ = false;
+
+    std::thread worker_;
+
+    explicit ConfigWriter();
+
+    static std::string toKey_(const std::filesystem::path& path);
+
+    void run_();
+    /**
+     * @brief Writes the contents unless they match the last write to the same
+     * path. Call without the mutex locked.
+     *
+     * @returns false if the file could not be written.
+     */
+    bool write_(const std::string& key, const PendingWrite& write);
+    /**
+     * @brief Appends the contents past offset to the file, if the file is
+     * still offset bytes long.
+     *
+     * @returns Whether the contents were appended.
+     */
+    bool append_(const PendingWrite& write, std::size_t offset);
+
+public:
+    ConfigWriter(const ConfigWriter&) = delete;
+    ConfigWriter(ConfigWriter&&) = delete;
+    ConfigWriter& operator=(const ConfigWriter&) = delete;
+    ConfigWriter& operator=(ConfigWriter&&) = delete;
+
+    /**
+     * @brief Stops the worker thread and joins it.
+     *
+     * @details Pending writes are only finished if the worker thread is still
+     * running. When the game exits, its threads are terminated before static
+     * destructors run, if those run at all. Callers that must not lose a write
+     * wait for it with flush() instead.
+     */
+    ~ConfigWriter();
+
+    static ConfigWriter& getInstance()
+    {
+        static ConfigWriter instance;
+        return instance;
+    }
+
+    /**
+     * @brief Queues the contents to be written to the given path, replacing
+     * any pending write to the same path.
+     *
+     * @param[in] onWritten Called once the contents, or contents queued later
+     * for the same path, are written.
+     */
+    void enqueue(
+        const std::filesystem::path& path,
+        std::string contents,
+        WriteCallback onWritten = nullptr);
+
+    /**
+     * @brief Records the contents just read from the given file as if they
+     * were last written to it, so that the next save can append to the file
+     * or skip it.
+     */
+    void recordContents(
+        const std::filesystem::path& path,
+        std::string_view contents);
+
+    /**
+     * @brief Blocks until there are no pending or in-progress writes to the
+     * given path.
+     */
+    void flush(const std::filesystem::path& path);
+
+    /**
+     * @brief Blocks until all pending writes are finished. Called when the
+     * game is saved, so that the files saved by scripts are on disk along
+     * with the save.
+     */
+    void flushAll();
+};
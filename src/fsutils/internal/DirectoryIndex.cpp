@@ -0,0 +1,178 @@
+#include "DirectoryIndex.hpp"
+
+#include <algorithm>
+#include <system_error>
+#include <utility>
+
+#include "../../utilities/stringutils.hpp"
+
+// Note to Future Me: Do not handle exceptions here. Let them propagate to the
+//                    actual Papyrus call so that we have access to the
+//                    Papyrus VM context for logging.
+
+namespace {
+    /**
+     * @brief Matches the name against a pattern with '*' and '?' wildcards.
+     * Both must have the same case.
+     */
+    bool matchesGlob_(
+        const std::string_view name,
+        const std::string_view pattern)
+    {
+        std::size_t nameIndex = 0;
+        std::size_t patternIndex = 0;
+        // Where to resume after the last '*' if the rest doesn't match.
+        std::size_t starPatternIndex = std::string_view::npos;
+        std::size_t starNameIndex = 0;
+
+        while (nameIndex < name.size()) {
+            if (patternIndex < pattern.size() &&
+                (pattern[patternIndex] == '?' ||
+                 pattern[patternIndex] == name[nameIndex])) {
+                ++nameIndex;
+                ++patternIndex;
+            } else if (
+                patternIndex < pattern.size() && pattern[patternIndex] == '*') {
+                starPatternIndex = patternIndex++;
+                starNameIndex = nameIndex;
+            } else if (starPatternIndex != std::string_view::npos) {
+                patternIndex = starPatternIndex + 1;
+                nameIndex = ++starNameIndex;
+            } else {
+                return false;
+            }
+        }
+
+        while (patternIndex < pattern.size() && pattern[patternIndex] == '*') {
+            ++patternIndex;
+        }
+
+        return patternIndex == pattern.size();
+    }
+} // namespace
+
+std::string DirectoryIndex::toKey_(const std::filesystem::path& directory)
+{
+    auto key = getLowerString(directory.lexically_normal().string());
+
+    // "Data/" and "Data" are the same directory.
+    while (key.size() > 1 && (key.back() == '/' || key.back() == '\\')) {
+        key.pop_back();
+    }
+
+    return key;
+}
+
+void DirectoryIndex::list_(
+    const std::filesystem::path& directory,
+    Listing& listing)
+{
+    listing.entries.clear();
+
+    std::error_code error;
+    listing.lastWriteTime = std::filesystem::last_write_time(directory, error);
+    listing.exists = !error && std::filesystem::is_directory(directory, error);
+
+    if (!listing.exists) {
+        return;
+    }
+
+    for (const auto& entry :
+         std::filesystem::directory_iterator(directory, error)) {
+        auto name = entry.path().filename().string();
+        auto key = getLowerString(name);
+
+        listing.entries.insert_or_assign(
+            std::move(key),
+            Entry{std::move(name), entry.is_directory(error)});
+    }
+}
+
+const DirectoryIndex::Listing&
+    DirectoryIndex::getListing_(const std::filesystem::path& directory)
+{
+    const auto now = Clock::now();
+    auto [it, isNew] = listings_.try_emplace(toKey_(directory));
+    auto& listing = it->second;
+
+    if (isNew) {
+        list_(directory, listing);
+    } else if (now - listing.lastValidated >= RevalidationInterval) {
+        std::error_code error;
+        const auto lastWriteTime =
+            std::filesystem::last_write_time(directory, error);
+
+        // Adding or removing an entry changes the directory's modification
+        // time, so the listing is still valid if it didn't change.
+        if (listing.exists == static_cast<bool>(error) ||
+            (!error && lastWriteTime != listing.lastWriteTime)) {
+            list_(directory, listing);
+        }
+    }
+
+    listing.lastValidated = now;
+
+    return listing;
+}
+
+bool DirectoryIndex::exists(const std::filesystem::path& path)
+{
+    auto normalizedPath = path.lexically_normal();
+
+    if (!normalizedPath.has_filename()) {
+        normalizedPath = normalizedPath.parent_path();
+    }
+
+    if (!normalizedPath.has_parent_path()) {
+        // Nothing to look the path up in.
+        return std::filesystem::exists(normalizedPath);
+    }
+
+    const auto name = getLowerString(normalizedPath.filename().string());
+
+    std::lock_guard lock(mutex_);
+
+    return getListing_(normalizedPath.parent_path()).entries.contains(name);
+}
+
+std::vector<std::string> DirectoryIndex::listFiles(
+    const std::filesystem::path& directory,
+    const std::string_view pattern)
+{
+    const auto lowerPattern = getLowerString(pattern);
+    std::vector<std::pair<std::string_view, std::string>> matches;
+
+    {
+        std::lock_guard lock(mutex_);
+
+        for (const auto& [key, entry] : getListing_(directory).entries) {
+            if (!entry.isDirectory && matchesGlob_(key, lowerPattern)) {
+                matches.emplace_back(key, entry.name);
+            }
+        }
+
+        // Sort while the keys are still valid.
+        std::ranges::sort(matches);
+    }
+
+    std::vector<std::string> names;
+    names.reserve(matches.size());
+
+    for (auto& [key, name] : matches) { names.push_back(std::move(name)); }
+
+    return names;
+}
+
+void DirectoryIndex::invalidate(const std::filesystem::path& directory)
+{
+    std::lock_guard lock(mutex_);
+
+    listings_.erase(toKey_(directory));
+}
+
+void DirectoryIndex::clear()
+{
+    std::lock_guard lock(mutex_);
+
+    listings_.clear();
+}
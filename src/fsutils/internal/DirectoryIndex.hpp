@@ -0,0 +1,101 @@
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Caches directory listings so that repeated file queries don't touch
+ * the disk.
+ *
+ * @details Directories are listed the first time a file in them is queried.
+ * A listing is trusted for RevalidationInterval after it was last checked.
+ * After that, the next query compares the directory's modification time and
+ * lists it again if it changed. Writes made by YASTMFSUtils itself invalidate
+ * the listing right away.
+ *
+ * Lookups are case-insensitive, like the Windows file system.
+ */
+class DirectoryIndex {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::chrono::seconds RevalidationInterval{2};
+
+private:
+    struct Entry {
+        /**
+         * @brief The name with its original case.
+         */
+        std::string name;
+        bool isDirectory;
+    };
+
+    struct Listing {
+        bool exists = false;
+        std::filesystem::file_time_type lastWriteTime;
+        Clock::time_point lastValidated;
+        /**
+         * @brief The directory's entries, keyed by lowercase name.
+         */
+        std::unordered_map<std::string, Entry> entries;
+    };
+
+    /**
+     * @brief Listings keyed by lowercase normalized directory path.
+     */
+    std::unordered_map<std::string, Listing> listings_;
+    std::mutex mutex_;
+
+    explicit DirectoryIndex() = default;
+
+    static std::string toKey_(const std::filesystem::path& directory);
+    static void list_(const std::filesystem::path& directory, Listing& listing);
+
+    /**
+     * @brief Returns the up-to-date listing of the directory. Call with the
+     * mutex held.
+     */
+    const Listing& getListing_(const std::filesystem::path& directory);
+
+public:
+    DirectoryIndex(const DirectoryIndex&) = delete;
+    DirectoryIndex(DirectoryIndex&&) = delete;
+    DirectoryIndex& operator=(const DirectoryIndex&) = delete;
+    DirectoryIndex& operator=(DirectoryIndex&&) = delete;
+
+    static DirectoryIndex& getInstance()
+    {
+        static DirectoryIndex instance;
+        return instance;
+    }
+
+    /**
+     * @brief Returns whether the file or directory exists.
+     */
+    bool exists(const std::filesystem::path& path);
+
+    /**
+     * @brief Returns the names of the files in the directory matching the
+     * pattern, sorted case-insensitively. The pattern may contain '*' (any
+     * number of characters) and '?' (any single character).
+     */
+    std::vector<std::string> listFiles(
+        const std::filesystem::path& directory,
+        std::string_view pattern);
+
+    /**
+     * @brief Drops the listing of the directory, so that the next query lists
+     * it again. Call after changing its contents.
+     */
+    void invalidate(const std::filesystem::path& directory);
+
+    /**
+     * @brief Drops every listing. Called when a game is started or loaded.
+     */
+    void clear();
+};
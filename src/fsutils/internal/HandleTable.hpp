@@ -0,0 +1,300 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Maps generation-tagged integer handles to shared objects.
+ *
+ * @details Objects are stored in a slab of slots that is allocated in chunks
+ * and never shrinks. A handle packs the slot index in the lower IndexBits bits
+ * and the slot's generation in the GenerationBits bits above it. The
+ * generation is bumped every time a slot is reused, so a closed handle stays
+ * invalid even after its slot is given to a new object. Freed slots are reused
+ * in FIFO order, which keeps the same handle value from coming back for as
+ * long as possible.
+ *
+ * Handles are always positive, so 0 (and any negative value) is never a valid
+ * handle.
+ *
+ * get() doesn't take the table's mutex. It only loads the slot's atomic shared
+ * pointer, which the standard library may guard with a small internal lock.
+ * insert() and erase() are serialized by the mutex.
+ */
+template <typename T>
+class HandleTable {
+public:
+    using HandleType = int;
+    using ValueType = std::shared_ptr<T>;
+
+    static constexpr unsigned int IndexBits = 20;
+    static constexpr unsigned int GenerationBits = 11;
+
+private:
+    static_assert(
+        IndexBits + GenerationBits < sizeof(HandleType) * 8,
+        "Handles must fit in the positive range of HandleType");
+
+    static constexpr std::size_t ChunkSize = 256;
+    static constexpr std::size_t MaxSlots = std::size_t{1} << IndexBits;
+    static constexpr std::size_t MaxChunks = MaxSlots / ChunkSize;
+    static constexpr std::uint32_t MaxGeneration =
+        (std::uint32_t{1} << GenerationBits) - 1;
+
+    struct Slot {
+        /**
+         * @brief The handle of the object currently stored in the slot, or 0
+         * if the slot is free.
+         */
+        std::atomic<HandleType> handle = 0;
+        std::atomic<ValueType> value;
+        /**
+         * @brief The generation of the last handle given out for this slot.
+         * Only accessed with the table mutex held.
+         */
+        std::uint32_t generation = 0;
+    };
+
+    using Chunk = std::array<Slot, ChunkSize>;
+
+    std::array<std::atomic<Chunk*>, MaxChunks> chunks_{};
+    std::size_t slotCount_ = 0;
+    std::deque<std::size_t> freeIndices_;
+    std::atomic<std::size_t> size_ = 0;
+    mutable std::mutex mutex_;
+
+    static HandleType makeHandle_(
+        const std::size_t index,
+        const std::uint32_t generation) noexcept
+    {
+        return static_cast<HandleType>(
+            (static_cast<std::uint32_t>(generation) << IndexBits) |
+            static_cast<std::uint32_t>(index));
+    }
+
+    static std::size_t indexOf_(const HandleType handle) noexcept
+    {
+        return static_cast<std::uint32_t>(handle) & (MaxSlots - 1);
+    }
+
+    static std::uint32_t nextGeneration_(const std::uint32_t generation)
+    {
+        // Generation 0 is skipped so that no handle is ever 0.
+        return generation >= MaxGeneration ? 1 : generation + 1;
+    }
+
+    Slot* findSlot_(const std::size_t index) const noexcept
+    {
+        const auto chunk =
+            chunks_[index / ChunkSize].load(std::memory_order_acquire);
+
+        if (chunk == nullptr) {
+            return nullptr;
+        }
+
+        return &(*chunk)[index % ChunkSize];
+    }
+
+    /**
+     * @brief Returns the index of the slot to use for the next insertion,
+     * allocating a new chunk if needed. Call with the mutex held.
+     */
+    std::size_t acquireIndex_()
+    {
+        if (!freeIndices_.empty()) {
+            const auto index = freeIndices_.front();
+            freeIndices_.pop_front();
+            return index;
+        }
+
+        if (slotCount_ >= MaxSlots) {
+            throw std::runtime_error("Too many open handles");
+        }
+
+        const auto index = slotCount_;
+        auto& chunk = chunks_[index / ChunkSize];
+
+        if (chunk.load(std::memory_order_relaxed) == nullptr) {
+            chunk.store(new Chunk(), std::memory_order_release);
+        }
+
+        ++slotCount_;
+        return index;
+    }
+
+    /**
+     * @brief Frees the slot if it holds the given handle. Call with the mutex
+     * held.
+     */
+    ValueType erase_(const HandleType handle)
+    {
+        const auto slot = handle > 0 ? findSlot_(indexOf_(handle)) : nullptr;
+
+        if (slot == nullptr ||
+            slot->handle.load(std::memory_order_relaxed) != handle) {
+            return nullptr;
+        }
+
+        slot->handle.store(0, std::memory_order_release);
+        auto value = slot->value.exchange(nullptr, std::memory_order_acq_rel);
+
+        freeIndices_.push_back(indexOf_(handle));
+        size_.fetch_sub(1, std::memory_order_relaxed);
+
+        return value;
+    }
+
+public:
+    explicit HandleTable() = default;
+    HandleTable(const HandleTable&) = delete;
+    HandleTable(HandleTable&&) = delete;
+    HandleTable& operator=(const HandleTable&) = delete;
+    HandleTable& operator=(HandleTable&&) = delete;
+
+    ~HandleTable()
+    {
+        for (auto& chunk : chunks_) { delete chunk.load(); }
+    }
+
+    /**
+     * @brief Stores the object and returns its new handle.
+     *
+     * @throws std::runtime_error All slots are in use.
+     */
+    HandleType insert(ValueType value)
+    {
+        std::lock_guard lock(mutex_);
+
+        const auto index = acquireIndex_();
+        auto& slot = *findSlot_(index);
+
+        slot.generation = nextGeneration_(slot.generation);
+
+        const auto handle = makeHandle_(index, slot.generation);
+
+        // The value must be visible before the handle is, since readers check
+        // the handle first.
+        slot.value.store(std::move(value), std::memory_order_release);
+        slot.handle.store(handle, std::memory_order_release);
+        size_.fetch_add(1, std::memory_order_relaxed);
+
+        return handle;
+    }
+
+    /**
+     * @brief Removes the object with the given handle.
+     *
+     * @returns The removed object, or nullptr if the handle is not valid. The
+     * object stays alive as long as someone still holds a pointer to it.
+     */
+    ValueType erase(const HandleType handle)
+    {
+        std::lock_guard lock(mutex_);
+
+        return erase_(handle);
+    }
+
+    /**
+     * @brief Removes all objects.
+     */
+    void clear()
+    {
+        std::lock_guard lock(mutex_);
+
+        for (std::size_t index = 0; index < slotCount_; ++index) {
+            const auto handle =
+                findSlot_(index)->handle.load(std::memory_order_relaxed);
+
+            if (handle != 0) {
+                erase_(handle);
+            }
+        }
+    }
+
+    /**
+     * @brief Returns the object with the given handle, or nullptr if the
+     * handle is not valid.
+     */
+    ValueType get(const HandleType handle) const
+    {
+        if (handle <= 0) {
+            return nullptr;
+        }
+
+        const auto slot = findSlot_(indexOf_(handle));
+
+        if (slot == nullptr ||
+            slot->handle.load(std::memory_order_acquire) != handle) {
+            return nullptr;
+        }
+
+        auto value = slot->value.load(std::memory_order_acquire);
+
+        // The handle may have been closed (and the slot reused) between the
+        // two loads.
+        if (slot->handle.load(std::memory_order_acquire) != handle) {
+            return nullptr;
+        }
+
+        return value;
+    }
+
+    std::size_t size() const noexcept
+    {
+        return size_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Calls fn(handle, value) for every stored object, with the mutex
+     * held.
+     */
+    void forEach(
+        const std::function<void(HandleType, const ValueType&)>& fn) const
+    {
+        std::lock_guard lock(mutex_);
+
+        for (std::size_t index = 0; index < slotCount_; ++index) {
+            const auto& slot = *findSlot_(index);
+            const auto handle = slot.handle.load(std::memory_order_relaxed);
+
+            if (handle != 0) {
+                fn(handle, slot.value.load(std::memory_order_relaxed));
+            }
+        }
+    }
+
+    /**
+     * @brief Returns the handle that the next insert() will return, assuming
+     * nothing else is inserted or erased in the meantime.
+     */
+    HandleType peekNextHandle() const
+    {
+        std::lock_guard lock(mutex_);
+
+        if (!freeIndices_.empty()) {
+            const auto index = freeIndices_.front();
+
+            return makeHandle_(
+                index,
+                nextGeneration_(findSlot_(index)->generation));
+        }
+
+        if (slotCount_ >= MaxSlots) {
+            return 0;
+        }
+
+        const auto slot = findSlot_(slotCount_);
+
+        return makeHandle_(
+            slotCount_,
+            nextGeneration_(slot != nullptr ? slot->generation : 0));
+    }
+};
@@ -0,0 +1,116 @@
+#include "IoExecutor.hpp"
+
+#include <atomic>
+#include <exception>
+#include <system_error>
+#include <utility>
+
+#include "../../global.hpp"
+
+using namespace std::literals;
+
+namespace {
+    std::shared_ptr<IoExecutor> createDefaultExecutor_()
+    {
+        try {
+            return std::make_shared<WorkerIoExecutor>();
+        } catch (const std::system_error& error) {
+            // The latent natives then block their script like the other
+            // natives, but still work.
+            LOG_ERROR_FMT(
+                "Could not start the I/O worker thread: {}. Running latent "
+                "file operations on the calling thread instead."sv,
+                error.what());
+            return std::make_shared<SynchronousIoExecutor>();
+        }
+    }
+
+    std::atomic<std::shared_ptr<IoExecutor>>& getExecutorSlot_()
+    {
+        static std::atomic<std::shared_ptr<IoExecutor>> executor(
+            createDefaultExecutor_());
+        return executor;
+    }
+} // namespace
+
+WorkerIoExecutor::WorkerIoExecutor()
+    : state_(std::make_shared<SharedState>())
+    , worker_([state = state_] { run_(state); })
+{}
+
+WorkerIoExecutor::~WorkerIoExecutor()
+{
+    {
+        std::lock_guard lock(state_->mutex);
+        state_->isStopping = true;
+    }
+
+    state_->jobAvailable.notify_one();
+
+    // A job may drop the last reference to the executor, e.g. while
+    // setIoExecutor() replaces it. The worker can't join itself, but it only
+    // uses the shared state, so let it finish on its own.
+    if (worker_.get_id() == std::this_thread::get_id()) {
+        worker_.detach();
+    } else if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+void WorkerIoExecutor::submit(Job job)
+{
+    {
+        std::lock_guard lock(state_->mutex);
+        state_->jobs.push_back(std::move(job));
+    }
+
+    state_->jobAvailable.notify_one();
+}
+
+void WorkerIoExecutor::run_(const std::shared_ptr<SharedState>& state)
+{
+    std::unique_lock lock(state->mutex);
+
+    while (true) {
+        state->jobAvailable.wait(lock, [&] {
+            return state->isStopping || !state->jobs.empty();
+        });
+
+        // Only stop once the queued jobs are done, so that the scripts waiting
+        // on them get their results.
+        if (state->jobs.empty()) {
+            return;
+        }
+
+        auto job = std::move(state->jobs.front());
+        state->jobs.pop_front();
+
+        lock.unlock();
+
+        try {
+            job();
+        } catch (const std::exception& error) {
+            // Jobs are expected to report their own errors. This only keeps
+            // the worker alive if one doesn't.
+            LOG_ERROR_FMT("Unhandled error in I/O job: {}"sv, error.what());
+        }
+
+        // Release what the job captured before locking, in case that
+        // destroys the executor.
+        job = nullptr;
+
+        lock.lock();
+    }
+}
+
+std::shared_ptr<IoExecutor> getIoExecutor()
+{
+    return getExecutorSlot_().load();
+}
+
+void setIoExecutor(std::shared_ptr<IoExecutor> executor)
+{
+    // Release the previous executor outside the slot's lock, since waiting for
+    // its jobs may take a while and the jobs may look up the executor.
+    const auto previous = getExecutorSlot_().exchange(std::move(executor));
+}
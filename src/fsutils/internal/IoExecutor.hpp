@@ -0,0 +1,88 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+/**
+ * @brief Runs file operations for the latent YASTMFSUtils natives.
+ */
+class IoExecutor {
+public:
+    using Job = std::function<void()>;
+
+    virtual ~IoExecutor() {}
+
+    /**
+     * @brief Queues the job to run. Jobs run in the order they are submitted.
+     */
+    virtual void submit(Job job) = 0;
+};
+
+/**
+ * @brief Runs jobs one at a time on a background thread, so that a slow disk
+ * doesn't stall the Papyrus VM.
+ */
+class WorkerIoExecutor : public IoExecutor {
+    struct SharedState {
+        std::deque<Job> jobs;
+
+        std::mutex mutex;
+        std::condition_variable jobAvailable;
+        bool isStopping = false;
+    };
+
+    /**
+     * @brief The queue, shared with the worker thread. The worker keeps it
+     * alive, so that it can finish the queued jobs even if one of them
+     * releases the last reference to the executor.
+     */
+    std::shared_ptr<SharedState> state_;
+
+    std::thread worker_;
+
+    static void run_(const std::shared_ptr<SharedState>& state);
+
+public:
+    /**
+     * @throws std::system_error The worker thread could not be started.
+     */
+    explicit WorkerIoExecutor();
+    /**
+     * @brief Lets the worker thread finish the queued jobs, then joins it.
+     */
+    ~WorkerIoExecutor() override;
+
+    WorkerIoExecutor(const WorkerIoExecutor&) = delete;
+    WorkerIoExecutor(WorkerIoExecutor&&) = delete;
+    WorkerIoExecutor& operator=(const WorkerIoExecutor&) = delete;
+    WorkerIoExecutor& operator=(WorkerIoExecutor&&) = delete;
+
+    void submit(Job job) override;
+};
+
+/**
+ * @brief Runs jobs immediately on the calling thread. Used when the worker
+ * thread can't be started, and useful for testing the latent natives without
+ * one.
+ */
+class SynchronousIoExecutor : public IoExecutor {
+public:
+    void submit(Job job) override { job(); }
+};
+
+/**
+ * @brief Returns the executor used by the latent natives. Defaults to a
+ * WorkerIoExecutor, or a SynchronousIoExecutor if its thread can't be started.
+ */
+std::shared_ptr<IoExecutor> getIoExecutor();
+
+/**
+ * @brief Replaces the executor used by the latent natives. Jobs already
+ * submitted to the previous executor still run there. If this releases the
+ * last reference to a WorkerIoExecutor, it waits for those jobs to finish.
+ */
+void setIoExecutor(std::shared_ptr<IoExecutor> executor);
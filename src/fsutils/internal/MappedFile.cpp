@@ -0,0 +1,90 @@
+#include "MappedFile.hpp"
+
+#include <string>
+#include <system_error>
+
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+
+namespace {
+    [[noreturn]] void throwLastError_(
+        const std::string& what,
+        const std::filesystem::path& path)
+    {
+        throw std::system_error(
+            static_cast<int>(::GetLastError()),
+            std::system_category(),
+            what + " \"" + path.string() + "\"");
+    }
+} // namespace
+
+MappedFile::MappedFile(const std::filesystem::path& path)
+{
+    file_ = ::CreateFileW(
+        path.c_str(),
+        GENERIC_READ,
+        // The file may be appended to or replaced while it's mapped.
+        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+        nullptr);
+
+    if (file_ == INVALID_HANDLE_VALUE) {
+        file_ = nullptr;
+        throwLastError_("Could not open file", path);
+    }
+
+    LARGE_INTEGER fileSize;
+
+    if (!::GetFileSizeEx(file_, &fileSize)) {
+        close_();
+        throwLastError_("Could not get size of file", path);
+    }
+
+    size_ = static_cast<std::size_t>(fileSize.QuadPart);
+
+    // Empty files can't be mapped.
+    if (size_ == 0) {
+        return;
+    }
+
+    mapping_ =
+        ::CreateFileMappingW(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+    if (mapping_ == nullptr) {
+        close_();
+        throwLastError_("Could not map file", path);
+    }
+
+    data_ = static_cast<const char*>(
+        ::MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+
+    if (data_ == nullptr) {
+        close_();
+        throwLastError_("Could not map view of file", path);
+    }
+}
+
+MappedFile::~MappedFile() { close_(); }
+
+void MappedFile::close_() noexcept
+{
+    if (data_ != nullptr) {
+        ::UnmapViewOfFile(data_);
+        data_ = nullptr;
+    }
+
+    if (mapping_ != nullptr) {
+        ::CloseHandle(mapping_);
+        mapping_ = nullptr;
+    }
+
+    if (file_ != nullptr) {
+        ::CloseHandle(file_);
+        file_ = nullptr;
+    }
+
+    size_ = 0;
+}
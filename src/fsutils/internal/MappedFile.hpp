@@ -0,0 +1,33 @@
+#pragma once
+
+#include <filesystem>
+#include <string_view>
+
+#include <cstddef>
+
+/**
+ * @brief Maps a file into memory for reading.
+ */
+class MappedFile {
+    void* file_ = nullptr;
+    void* mapping_ = nullptr;
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+
+    void close_() noexcept;
+
+public:
+    /**
+     * @throws std::system_error The file could not be opened or mapped.
+     */
+    explicit MappedFile(const std::filesystem::path& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile(MappedFile&&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile& operator=(MappedFile&&) = delete;
+
+    std::string_view view() const noexcept { return {data_, size_}; }
+    std::size_t size() const noexcept { return size_; }
+};
@@ -0,0 +1,114 @@
+#include "ParsedConfigCache.hpp"
+
+#include <iterator>
+#include <system_error>
+#include <utility>
+
+#include "MappedFile.hpp"
+#include "../../utilities/stringutils.hpp"
+
+// Note to Future Me: Do not handle exceptions here. Let them propagate to the
+//                    actual Papyrus call so that we have access to the
+//                    Papyrus VM context for logging.
+
+ParsedConfigCache::TablePointer
+    ParsedConfigCache::get(const std::filesystem::path& path)
+{
+    const auto canonicalPath = std::filesystem::canonical(path);
+    const auto fileSize = std::filesystem::file_size(canonicalPath);
+    const auto lastWriteTime = std::filesystem::last_write_time(canonicalPath);
+    // Windows paths are case-insensitive.
+    auto key = getLowerString(canonicalPath.string());
+
+    {
+        std::lock_guard lock(mutex_);
+
+        if (const auto it = keyToEntryMap_.find(key);
+            it != keyToEntryMap_.end()) {
+            const auto entry = it->second;
+
+            if (entry->fileSize == fileSize &&
+                entry->lastWriteTime == lastWriteTime) {
+                entries_.splice(entries_.begin(), entries_, entry);
+                return entry->table;
+            }
+
+            // The file changed since it was cached.
+            erase_(entry);
+        }
+    }
+
+    // Parse without holding the lock so that other files can still be looked
+    // up in the meantime.
+    const auto canonicalPathStr = canonicalPath.string();
+    const MappedFile file(canonicalPath);
+    auto table = std::make_shared<const toml::table>(
+        toml::parse(file.view(), canonicalPathStr));
+
+    if (fileSize > MaxCachedBytes) {
+        return table;
+    }
+
+    std::lock_guard lock(mutex_);
+
+    // Another thread may have parsed the same file in the meantime.
+    if (const auto it = keyToEntryMap_.find(key); it != keyToEntryMap_.end()) {
+        erase_(it->second);
+    }
+
+    entries_.push_front(Entry{key, fileSize, lastWriteTime, table});
+    keyToEntryMap_.emplace(std::move(key), entries_.begin());
+    cachedBytes_ += static_cast<std::size_t>(fileSize);
+
+    evict_();
+
+    return table;
+}
+
+void ParsedConfigCache::erase_(const EntryList::iterator it)
+{
+    cachedBytes_ -= static_cast<std::size_t>(it->fileSize);
+    keyToEntryMap_.erase(it->key);
+    entries_.erase(it);
+}
+
+void ParsedConfigCache::evict_()
+{
+    while (cachedBytes_ > MaxCachedBytes && !entries_.empty()) {
+        erase_(std::prev(entries_.end()));
+    }
+}
+
+void ParsedConfigCache::erase(const std::filesystem::path& path)
+{
+    std::error_code error;
+    const auto canonicalPath = std::filesystem::canonical(path, error);
+
+    if (error) {
+        return;
+    }
+
+    const auto key = getLowerString(canonicalPath.string());
+
+    std::lock_guard lock(mutex_);
+
+    if (const auto it = keyToEntryMap_.find(key); it != keyToEntryMap_.end()) {
+        erase_(it->second);
+    }
+}
+
+void ParsedConfigCache::clear()
+{
+    std::lock_guard lock(mutex_);
+
+    keyToEntryMap_.clear();
+    entries_.clear();
+    cachedBytes_ = 0;
+}
+
+std::size_t ParsedConfigCache::cachedBytes() const
+{
+    std::lock_guard lock(mutex_);
+
+    return cachedBytes_;
+}
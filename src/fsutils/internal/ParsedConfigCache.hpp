@@ -0,0 +1,86 @@
+#pragma once
+
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <cstddef>
+#include <cstdint>
+
+#include <toml++/toml.h>
+
+/**
+ * @brief Caches parsed configuration files so that opening the same file
+ * several times only parses it once.
+ *
+ * @details Entries are keyed by canonical path and are only reused while the
+ * file's size and modification time are unchanged. Cached tables are immutable
+ * and shared by every configuration opened from them. The cache is bounded by
+ * the total size of the cached files, evicting the least recently used entries
+ * first. Evicted tables stay alive for as long as a configuration uses them.
+ */
+class ParsedConfigCache {
+public:
+    using TablePointer = std::shared_ptr<const toml::table>;
+
+    /**
+     * @brief The maximum total size of the cached files, in bytes.
+     */
+    static constexpr std::size_t MaxCachedBytes = 8 * 1024 * 1024;
+
+private:
+    struct Entry {
+        std::string key;
+        std::uintmax_t fileSize;
+        std::filesystem::file_time_type lastWriteTime;
+        TablePointer table;
+    };
+
+    using EntryList = std::list<Entry>;
+
+    /**
+     * @brief Entries ordered from most to least recently used.
+     */
+    EntryList entries_;
+    std::unordered_map<std::string, EntryList::iterator> keyToEntryMap_;
+    std::size_t cachedBytes_ = 0;
+    mutable std::mutex mutex_;
+
+    explicit ParsedConfigCache() = default;
+
+    void erase_(EntryList::iterator it);
+    void evict_();
+
+public:
+    ParsedConfigCache(const ParsedConfigCache&) = delete;
+    ParsedConfigCache(ParsedConfigCache&&) = delete;
+    ParsedConfigCache& operator=(const ParsedConfigCache&) = delete;
+    ParsedConfigCache& operator=(ParsedConfigCache&&) = delete;
+
+    static ParsedConfigCache& getInstance()
+    {
+        static ParsedConfigCache instance;
+        return instance;
+    }
+
+    /**
+     * @brief Returns the parsed contents of the file, parsing it if it's not
+     * cached or has changed since it was cached.
+     *
+     * @throws std::filesystem::filesystem_error The file does not exist.
+     * @throws toml::parse_error The file is not valid TOML.
+     */
+    TablePointer get(const std::filesystem::path& path);
+
+    /**
+     * @brief Removes the file from the cache, if it's cached.
+     */
+    void erase(const std::filesystem::path& path);
+
+    void clear();
+
+    std::size_t cachedBytes() const;
+};
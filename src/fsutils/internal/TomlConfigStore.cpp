@@ -0,0 +1,218 @@
+#include "TomlConfigStore.hpp"
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "ParsedConfigCache.hpp"
+
+// Note to Future Me: Do not handle exceptions here. Let them propagate to the
+//                    actual Papyrus call so that we have access to the
+//                    Papyrus VM context for logging.
+
+namespace {
+    /**
+     * @brief Calls fn for every int and float in the table and its subtables.
+     *
+     * @returns The number of entries of other types.
+     */
+    std::size_t forEachValueIn_(
+        const toml::table& table,
+        const std::string& prefix,
+        const ConfigStore::ValueCallback& fn)
+    {
+        std::size_t skippedCount = 0;
+
+        for (const auto& [key, node] : table) {
+            const auto fullKey = prefix + std::string(key.str());
+
+            if (const auto subtable = node.as_table(); subtable != nullptr) {
+                skippedCount += forEachValueIn_(*subtable, fullKey + ".", fn);
+            } else if (const auto value = node.as_integer(); value != nullptr) {
+                fn(fullKey, ConfigValue(value->get()));
+            } else if (const auto value = node.as_floating_point();
+                       value != nullptr) {
+                fn(fullKey, ConfigValue(value->get()));
+            } else {
+                ++skippedCount;
+            }
+        }
+
+        return skippedCount;
+    }
+
+    /**
+     * @brief Returns a rough estimate of the memory used by the node,
+     * including its children.
+     */
+    std::size_t estimateMemoryUsageOf_(const toml::node& node)
+    {
+        // Every entry holds a key and a pointer to a separately allocated
+        // node. The largest leaf node is a string value.
+        constexpr std::size_t entrySize = sizeof(toml::key) + sizeof(void*);
+        constexpr std::size_t leafSize = sizeof(toml::value<std::string>);
+
+        if (const auto table = node.as_table(); table != nullptr) {
+            std::size_t size = sizeof(toml::table);
+
+            for (const auto& [key, child] : *table) {
+                size += entrySize + key.str().size() +
+                        estimateMemoryUsageOf_(child);
+            }
+
+            return size;
+        }
+
+        if (const auto array = node.as_array(); array != nullptr) {
+            std::size_t size = sizeof(toml::array);
+
+            for (const auto& child : *array) {
+                size += sizeof(void*) + estimateMemoryUsageOf_(child);
+            }
+
+            return size;
+        }
+
+        if (const auto str = node.as_string(); str != nullptr) {
+            return leafSize + str->get().size();
+        }
+
+        return leafSize;
+    }
+} // namespace
+
+TomlConfigStore::TomlConfigStore()
+    : privateData_(std::make_shared<toml::table>())
+{
+    data_ = privateData_;
+}
+
+TomlConfigStore::TomlConfigStore(const std::filesystem::path& path)
+    : data_(ParsedConfigCache::getInstance().get(path))
+{}
+
+TomlConfigStore::TomlConfigStore(std::shared_ptr<const toml::table> data)
+    : data_(std::move(data))
+{}
+
+toml::table& TomlConfigStore::mutableData_()
+{
+    if (privateData_ == nullptr) {
+        privateData_ = std::make_shared<toml::table>(*data_);
+        data_ = privateData_;
+    }
+
+    return *privateData_;
+}
+
+const toml::node* TomlConfigStore::find_(
+    const std::string_view key,
+    const PathSegments segments) const
+{
+    // A top-level key containing dots takes precedence over the path.
+    if (const auto node = data_->get(key); node != nullptr) {
+        return node;
+    }
+
+    if (segments.size() <= 1) {
+        return nullptr;
+    }
+
+    const toml::table* table = data_.get();
+    const toml::node* node = nullptr;
+
+    for (const auto segment : segments) {
+        if (table == nullptr) {
+            return nullptr;
+        }
+
+        node = table->get(segment);
+
+        if (node == nullptr) {
+            return nullptr;
+        }
+
+        table = node->as_table();
+    }
+
+    return node;
+}
+
+std::optional<std::int64_t> TomlConfigStore::getInt(
+    const std::string_view key,
+    const PathSegments segments) const
+{
+    return toml::node_view<const toml::node>(find_(key, segments))
+        .value<std::int64_t>();
+}
+
+std::optional<double> TomlConfigStore::getFloat(
+    const std::string_view key,
+    const PathSegments segments) const
+{
+    return toml::node_view<const toml::node>(find_(key, segments))
+        .value<double>();
+}
+
+bool TomlConfigStore::insert(
+    const std::string_view key,
+    const PathSegments segments,
+    const ConfigValue& value)
+{
+    // Avoid copying a shared table when nothing would change.
+    if (find_(key, segments) != nullptr) {
+        return false;
+    }
+
+    // Check the path before changing anything, so that a failed insertion
+    // leaves the data untouched.
+    const toml::table* existingTable = data_.get();
+
+    for (std::size_t i = 0; i + 1 < segments.size(); ++i) {
+        const auto node = existingTable->get(segments[i]);
+
+        if (node == nullptr) {
+            break;
+        }
+
+        existingTable = node->as_table();
+
+        if (existingTable == nullptr) {
+            throw std::invalid_argument(
+                "Cannot set \"" + std::string(key) + "\": \"" +
+                std::string(segments[i]) + "\" is not a table");
+        }
+    }
+
+    toml::table* table = &mutableData_();
+
+    for (std::size_t i = 0; i + 1 < segments.size(); ++i) {
+        table = table->insert(segments[i], toml::table())
+                    .first->second.as_table();
+    }
+
+    std::visit(
+        [&](const auto value) { table->insert(segments.back(), value); },
+        value);
+
+    return true;
+}
+
+std::size_t TomlConfigStore::forEachValue(const ValueCallback& fn) const
+{
+    return forEachValueIn_(*data_, "", fn);
+}
+
+std::size_t TomlConfigStore::estimateMemoryUsage() const
+{
+    return sizeof(*this) + estimateMemoryUsageOf_(*data_);
+}
+
+std::string TomlConfigStore::serialize() const
+{
+    std::ostringstream stream;
+    stream << *data_;
+
+    return stream.str();
+}
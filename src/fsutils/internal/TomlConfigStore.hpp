@@ -0,0 +1,74 @@
+#pragma once
+
+#include <filesystem>
+#include <memory>
+
+#include <toml++/toml.h>
+
+#include "ConfigStore.hpp"
+
+/**
+ * @brief Stores a configuration as a TOML table.
+ *
+ * @details Keys are looked up as paths into nested tables, except that a
+ * top-level key containing dots takes precedence over the path, so files
+ * written before key paths were supported still work.
+ */
+class TomlConfigStore : public ConfigStore {
+    /**
+     * @brief The configuration data. Stores opened from a file share the
+     * table parsed by ParsedConfigCache until they are first changed.
+     */
+    std::shared_ptr<const toml::table> data_;
+    /**
+     * @brief The same table as data_ once this store has its own copy, or
+     * nullptr while the table is shared.
+     */
+    std::shared_ptr<toml::table> privateData_;
+
+    /**
+     * @brief Returns the table to modify, copying the shared table first if
+     * needed.
+     */
+    toml::table& mutableData_();
+
+    const toml::node* find_(std::string_view key, PathSegments segments) const;
+
+    explicit TomlConfigStore(std::shared_ptr<const toml::table> data);
+
+public:
+    explicit TomlConfigStore();
+    explicit TomlConfigStore(const std::filesystem::path& path);
+
+    ConfigFormat format() const noexcept override
+    {
+        return ConfigFormat::Toml;
+    }
+
+    bool has(std::string_view key, PathSegments segments) const override
+    {
+        return find_(key, segments) != nullptr;
+    }
+
+    std::optional<std::int64_t>
+        getInt(std::string_view key, PathSegments segments) const override;
+    std::optional<double>
+        getFloat(std::string_view key, PathSegments segments) const override;
+
+    std::unique_ptr<ConfigStore> clone() const override
+    {
+        // Share the table until either store changes it.
+        return std::unique_ptr<ConfigStore>(new TomlConfigStore(data_));
+    }
+
+    bool insert(
+        std::string_view key,
+        PathSegments segments,
+        const ConfigValue& value) override;
+
+    std::size_t forEachValue(const ValueCallback& fn) const override;
+
+    std::string serialize() const override;
+
+    std::size_t estimateMemoryUsage() const override;
+};
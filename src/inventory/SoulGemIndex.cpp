@@ -0,0 +1,223 @@
+#include "SoulGemIndex.hpp"
+
+#include <utility>
+
+#include <RE/S/ScriptEventSourceHolder.h>
+#include <RE/T/TESForm.h>
+#include <RE/T/TESObjectREFR.h>
+#include <RE/T/TESSoulGem.h>
+
+#include "../global.hpp"
+#include "../SoulValue.hpp"
+#include "../config/SoulGemMap.hpp"
+#include "../utilities/misc.hpp"
+
+using namespace std::literals;
+
+namespace {
+    /**
+     * @brief How many times to rescan an inventory that changed while it was
+     * being scanned before giving up on indexing it for now.
+     */
+    constexpr int MAX_SCAN_ATTEMPTS_ = 3;
+} // namespace
+
+void SoulGemIndex::initialize(const SoulGemMap& soulGemMap)
+{
+    const auto reusableKeyword = getReusableSoulGemKeyword();
+
+    soulGemClasses_.clear();
+
+    // Soul gem forms shared between dual and black soul gem groups are
+    // classified as dual soul gems, since those can hold both kinds of souls.
+    // forEachSoulGemCapacity() visits dual soul gems before black ones.
+    forEachSoulGemCapacity([&](const SoulGemCapacity capacity) {
+        for (SoulSizeValue containedSoulSize = SoulSize::First;
+             containedSoulSize <= SoulSize::Last;
+             ++containedSoulSize) {
+            const auto [begin, end] =
+                soulGemMap.getSoulGemsWith(capacity, containedSoulSize);
+
+            for (auto it = begin; it != end; ++it) {
+                if (const auto soulGem = it.get(); soulGem != nullptr) {
+                    soulGemClasses_.try_emplace(
+                        soulGem,
+                        SoulGemClass{
+                            capacity,
+                            containedSoulSize,
+                            soulGem->HasKeyword(reusableKeyword)});
+                }
+            }
+        }
+    });
+
+    LOG_INFO_FMT("Classified {} soul gem forms."sv, soulGemClasses_.size());
+
+    clear();
+
+    if (const auto eventSource = RE::ScriptEventSourceHolder::GetSingleton();
+        eventSource != nullptr) {
+        eventSource->AddEventSink<RE::TESContainerChangedEvent>(this);
+    } else {
+        LOG_ERROR("Could not listen to container change events."sv);
+    }
+}
+
+void SoulGemIndex::clear()
+{
+    std::lock_guard lock(mutex_);
+
+    inventories_.clear();
+    ++changeCount_;
+}
+
+const SoulGemClass* SoulGemIndex::classify(RE::TESSoulGem* const soulGem) const
+{
+    const auto it = soulGemClasses_.find(soulGem);
+
+    return it != soulGemClasses_.end() ? &it->second : nullptr;
+}
+
+SoulGemIndex::InventoryPointer
+    SoulGemIndex::scan_(RE::TESObjectREFR* const ref) const
+{
+    auto inventory = std::make_shared<SoulGemInventory>();
+
+    const auto inventoryMap =
+        getInventoryFor(ref, [](const RE::TESBoundObject& obj) {
+            return obj.IsSoulGem();
+        });
+
+    for (const auto& [obj, data] : inventoryMap) {
+        const auto soulGem = obj->As<RE::TESSoulGem>();
+        const auto count = data.first;
+
+        if (count <= 0) {
+            continue;
+        }
+
+        if (const auto soulGemClass = classify(soulGem);
+            soulGemClass != nullptr) {
+            inventory->add(soulGem, *soulGemClass, count);
+        }
+    }
+
+    return inventory;
+}
+
+SoulGemIndex::InventoryPointer
+    SoulGemIndex::get(RE::TESObjectREFR* const ref)
+{
+    const auto refId = ref->GetFormID();
+
+    {
+        std::lock_guard lock(mutex_);
+
+        if (const auto it = inventories_.find(refId);
+            it != inventories_.end()) {
+            return it->second;
+        }
+    }
+
+    // Scan without holding the lock, since changing the inventory in the
+    // meantime sends events that need it. If anything changed during the
+    // scan, the result may have missed it, so try again.
+    InventoryPointer inventory;
+
+    for (int attempt = 0; attempt < MAX_SCAN_ATTEMPTS_; ++attempt) {
+        const auto changeCount = changeCount_.load();
+
+        inventory = scan_(ref);
+
+        std::lock_guard lock(mutex_);
+
+        if (changeCount_.load() == changeCount) {
+            inventories_.insert_or_assign(refId, inventory);
+            return inventory;
+        }
+    }
+
+    LOG_TRACE_FMT(
+        "Inventory of {:08X} keeps changing. Not indexing it for now."sv,
+        refId);
+
+    return inventory;
+}
+
+void SoulGemIndex::invalidate(RE::TESObjectREFR* const ref)
+{
+    std::lock_guard lock(mutex_);
+
+    inventories_.erase(ref->GetFormID());
+    ++changeCount_;
+}
+
+void SoulGemIndex::applyChange_(
+    const RE::FormID refId,
+    RE::TESSoulGem* const soulGem,
+    const SoulGemClass& soulGemClass,
+    const SoulGemInventory::Count delta)
+{
+    const auto it = inventories_.find(refId);
+
+    if (it == inventories_.end()) {
+        return;
+    }
+
+    auto inventory = std::make_shared<SoulGemInventory>(*it->second);
+
+    if (inventory->add(soulGem, soulGemClass, delta)) {
+        it->second = std::move(inventory);
+    } else {
+        // The counts are out of date (e.g. the item was changed without an
+        // event). Scan the inventory again the next time it's needed.
+        LOG_TRACE_FMT(
+            "Soul gem counts for {:08X} are out of date. Discarding them."sv,
+            refId);
+        inventories_.erase(it);
+    }
+}
+
+RE::BSEventNotifyControl SoulGemIndex::ProcessEvent(
+    const RE::TESContainerChangedEvent* const event,
+    RE::BSTEventSource<RE::TESContainerChangedEvent>*)
+{
+    if (event == nullptr || event->itemCount == 0) {
+        return RE::BSEventNotifyControl::kContinue;
+    }
+
+    const auto soulGem =
+        RE::TESForm::LookupByID<RE::TESSoulGem>(event->baseObj);
+
+    if (soulGem == nullptr) {
+        return RE::BSEventNotifyControl::kContinue;
+    }
+
+    const auto soulGemClass = classify(soulGem);
+
+    if (soulGemClass == nullptr) {
+        return RE::BSEventNotifyControl::kContinue;
+    }
+
+    std::lock_guard lock(mutex_);
+
+    ++changeCount_;
+
+    if (event->oldContainer != 0) {
+        applyChange_(
+            event->oldContainer,
+            soulGem,
+            *soulGemClass,
+            -event->itemCount);
+    }
+
+    if (event->newContainer != 0) {
+        applyChange_(
+            event->newContainer,
+            soulGem,
+            *soulGemClass,
+            event->itemCount);
+    }
+
+    return RE::BSEventNotifyControl::kContinue;
+}
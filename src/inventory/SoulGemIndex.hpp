@@ -0,0 +1,113 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <cstdint>
+
+#include <RE/B/BSTEvent.h>
+#include <RE/F/FormTypes.h>
+#include <RE/T/TESContainerChangedEvent.h>
+
+#include "SoulGemInventory.hpp"
+
+namespace RE {
+    class TESObjectREFR;
+    class TESSoulGem;
+} // namespace RE
+
+class SoulGemMap;
+
+/**
+ * @brief Keeps the soul gems of each queried inventory counted by class, so
+ * that looking up which soul gems an actor owns does not need an inventory
+ * scan.
+ *
+ * An inventory is scanned once, the first time it's queried. The counts are
+ * then kept up to date from container change events.
+ */
+class SoulGemIndex : public RE::BSTEventSink<RE::TESContainerChangedEvent> {
+public:
+    using InventoryPointer = std::shared_ptr<const SoulGemInventory>;
+
+private:
+    /**
+     * @brief The class of every soul gem form in the soul gem map. Only
+     * written by initialize(), before any lookups.
+     */
+    std::unordered_map<RE::TESSoulGem*, SoulGemClass> soulGemClasses_;
+
+    /**
+     * @brief The published inventories. Never modified in place; changes
+     * replace the pointer so that callers can keep using their copy without
+     * locking anything.
+     */
+    std::unordered_map<RE::FormID, InventoryPointer> inventories_;
+    /**
+     * @brief Incremented on every soul gem change. Lets inventories scanned
+     * without holding the lock detect changes they may have missed.
+     */
+    std::atomic<std::uint64_t> changeCount_ = 0;
+    mutable std::mutex mutex_;
+
+    explicit SoulGemIndex() = default;
+
+    InventoryPointer scan_(RE::TESObjectREFR* ref) const;
+    /**
+     * @brief Applies a change to the inventory of the given reference, if it's
+     * indexed. Call with the mutex locked.
+     */
+    void applyChange_(
+        RE::FormID refId,
+        RE::TESSoulGem* soulGem,
+        const SoulGemClass& soulGemClass,
+        SoulGemInventory::Count delta);
+
+public:
+    [[nodiscard]] static SoulGemIndex& getInstance()
+    {
+        static SoulGemIndex instance;
+        return instance;
+    }
+
+    SoulGemIndex(const SoulGemIndex&) = delete;
+    SoulGemIndex(SoulGemIndex&&) = delete;
+    SoulGemIndex& operator=(const SoulGemIndex&) = delete;
+    SoulGemIndex& operator=(SoulGemIndex&&) = delete;
+
+    /**
+     * @brief Classifies the soul gems in the map and starts listening to
+     * container change events. Call once the soul gem map is loaded.
+     */
+    void initialize(const SoulGemMap& soulGemMap);
+
+    /**
+     * @brief Forgets all indexed inventories. Called when a game is loaded,
+     * since form IDs of references may be reused.
+     */
+    void clear();
+
+    /**
+     * @returns The class of the soul gem, or nullptr if it's not in the soul
+     * gem map.
+     */
+    const SoulGemClass* classify(RE::TESSoulGem* soulGem) const;
+
+    /**
+     * @brief Returns the soul gem counts of the reference's inventory,
+     * scanning it first if it's not indexed yet.
+     */
+    InventoryPointer get(RE::TESObjectREFR* ref);
+
+    /**
+     * @brief Discards the indexed counts of the reference's inventory. Call
+     * when they're found to be out of date.
+     */
+    void invalidate(RE::TESObjectREFR* ref);
+
+    RE::BSEventNotifyControl ProcessEvent(
+        const RE::TESContainerChangedEvent* event,
+        RE::BSTEventSource<RE::TESContainerChangedEvent>* source) override;
+};
@@ -0,0 +1,141 @@
+#include "SoulGemInventory.hpp"
+
+#include "../config/SoulGemMap.hpp"
+
+namespace {
+    bool isFullyFilled_(const SoulGemClass& soulGemClass)
+    {
+        // Dual soul gems are full with either a white grand or a black soul.
+        return soulGemClass.containedSoulSize >=
+               toSoulSize(soulGemClass.capacity);
+    }
+
+    int getSoulValue_(const SoulSize soulSize)
+    {
+        return static_cast<int>(toSoulLevelValue(soulSize));
+    }
+} // namespace
+
+std::vector<SoulGemCapacity> getSoulGemCapacitiesFor(
+    const SoulSize soulSize,
+    const bool allowPartiallyFillingSoulGems)
+{
+    if (soulSize == SoulSize::Black) {
+        return {SoulGemCapacity::Black, SoulGemCapacity::Dual};
+    }
+
+    std::vector<SoulGemCapacity> capacities;
+
+    const auto exactCapacity = toSoulGemCapacity(soulSize);
+    const auto maxCapacity = allowPartiallyFillingSoulGems
+                                 ? SoulGemCapacity::LastWhite
+                                 : exactCapacity;
+
+    for (SoulGemCapacityValue capacity = exactCapacity;
+         capacity <= maxCapacity;
+         ++capacity) {
+        capacities.push_back(capacity);
+    }
+
+    // The trap engine only moves grand souls into dual soul gems when
+    // partially filling soul gems is not allowed.
+    if (!allowPartiallyFillingSoulGems && soulSize == SoulSize::Grand) {
+        capacities.push_back(SoulGemCapacity::Dual);
+    }
+
+    return capacities;
+}
+
+bool SoulGemInventory::add(
+    RE::TESSoulGem* const soulGem,
+    const SoulGemClass& soulGemClass,
+    const Count delta)
+{
+    auto& entry =
+        formEntries_.try_emplace(soulGem, FormEntry{soulGemClass, 0})
+            .first->second;
+
+    if (entry.count + delta < 0) {
+        if (entry.count == 0) {
+            formEntries_.erase(soulGem);
+        }
+
+        return false;
+    }
+
+    entry.count += delta;
+
+    if (entry.count == 0) {
+        formEntries_.erase(soulGem);
+    }
+
+    counts_[soulGemClass.isReusable][soulGemClass.capacity]
+           [soulGemClass.containedSoulSize] += delta;
+    totalCount_ += delta;
+
+    if (isFullyFilled_(soulGemClass)) {
+        fullyFilledCount_ += delta;
+    }
+
+    const auto soulValue = getSoulValue_(soulGemClass.containedSoulSize);
+    const auto capacityValue = getSoulValue_(toSoulSize(soulGemClass.capacity));
+
+    storedSoulValue_ += soulValue * delta;
+    freeSoulValue_ += (capacityValue - soulValue) * delta;
+
+    return true;
+}
+
+SoulGemInventory::Count
+    SoulGemInventory::countOf(RE::TESSoulGem* const soulGem) const
+{
+    const auto it = formEntries_.find(soulGem);
+
+    return it != formEntries_.end() ? it->second.count : 0;
+}
+
+InventoryStatus SoulGemInventory::status() const noexcept
+{
+    if (totalCount_ <= 0) {
+        return InventoryStatus::NoSoulGemsOwned;
+    }
+
+    if (totalCount_ == fullyFilledCount_) {
+        return InventoryStatus::AllSoulGemsFilled;
+    }
+
+    return InventoryStatus::HasSoulGemsToFill;
+}
+
+RE::TESSoulGem* SoulGemInventory::findSoulGem(
+    const SoulGemMap& soulGemMap,
+    const SoulGemClass& soulGemClass) const
+{
+    if (count(soulGemClass) <= 0) {
+        return nullptr;
+    }
+
+    const auto [begin, end] = soulGemMap.getSoulGemsWith(
+        soulGemClass.capacity,
+        soulGemClass.containedSoulSize);
+
+    for (auto it = begin; it != end; ++it) {
+        const auto soulGem = it.get();
+
+        if (soulGem == nullptr) {
+            continue;
+        }
+
+        // Forms shared between black and dual soul gem groups are classified
+        // only once, so check the class as well.
+        if (const auto entryIt = formEntries_.find(soulGem);
+            entryIt != formEntries_.end() &&
+            entryIt->second.soulGemClass.capacity == soulGemClass.capacity &&
+            entryIt->second.soulGemClass.isReusable ==
+                soulGemClass.isReusable) {
+            return soulGem;
+        }
+    }
+
+    return nullptr;
+}
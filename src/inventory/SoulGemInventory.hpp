@@ -0,0 +1,160 @@
+#pragma once
+
+#include <array>
+#include <unordered_map>
+#include <vector>
+
+#include <RE/T/TESObjectREFR.h>
+
+#include "../SoulSize.hpp"
+#include "../SoulValue.hpp"
+#include "../trapsoul/InventoryStatus.hpp"
+#include "../utilities/EnumArray.hpp"
+
+namespace RE {
+    class TESSoulGem;
+} // namespace RE
+
+class SoulGemMap;
+
+/**
+ * @brief The class of a soul gem form, as listed in the soul gem map.
+ */
+struct SoulGemClass {
+    SoulGemCapacity capacity;
+    SoulSize containedSoulSize;
+    bool isReusable;
+};
+
+/**
+ * @brief Returns the soul gem capacities that may hold a soul of the given
+ * size under the trap engine's rules, in the order they should be filled.
+ */
+[[nodiscard]] std::vector<SoulGemCapacity> getSoulGemCapacitiesFor(
+    SoulSize soulSize,
+    bool allowPartiallyFillingSoulGems);
+
+/**
+ * @brief Counts the soul gems in an inventory by their class.
+ *
+ * Only soul gems listed in the soul gem map are counted. Souls stored in the
+ * extra data of a soul gem are not tracked, matching the trap engine.
+ */
+class SoulGemInventory {
+public:
+    using Count = RE::TESObjectREFR::Count;
+
+private:
+    using SoulSizeCounts = EnumArray<SoulSize, Count>;
+    using CapacityCounts = EnumArray<SoulGemCapacity, SoulSizeCounts>;
+
+    struct FormEntry {
+        SoulGemClass soulGemClass;
+        Count count;
+    };
+
+    /**
+     * @brief Counts indexed by [isReusable][capacity][containedSoulSize].
+     */
+    std::array<CapacityCounts, 2> counts_{};
+    std::unordered_map<RE::TESSoulGem*, FormEntry> formEntries_;
+    Count totalCount_ = 0;
+    Count fullyFilledCount_ = 0;
+    int storedSoulValue_ = 0;
+    int freeSoulValue_ = 0;
+
+public:
+    /**
+     * @brief Adds delta soul gems of the given form and class. delta may be
+     * negative.
+     *
+     * @returns False if the inventory holds fewer than -delta of the form, in
+     * which case nothing is changed.
+     */
+    bool add(
+        RE::TESSoulGem* soulGem,
+        const SoulGemClass& soulGemClass,
+        Count delta);
+
+    Count count(
+        const SoulGemCapacity capacity,
+        const SoulSize containedSoulSize,
+        const bool isReusable) const
+    {
+        return counts_[isReusable][capacity][containedSoulSize];
+    }
+
+    Count count(const SoulGemClass& soulGemClass) const
+    {
+        return count(
+            soulGemClass.capacity,
+            soulGemClass.containedSoulSize,
+            soulGemClass.isReusable);
+    }
+
+    Count count(
+        const SoulGemCapacity capacity,
+        const SoulSize containedSoulSize) const
+    {
+        return count(capacity, containedSoulSize, false) +
+               count(capacity, containedSoulSize, true);
+    }
+
+    Count countOf(RE::TESSoulGem* soulGem) const;
+
+    /**
+     * @brief The total soul value of the souls held in the soul gems, where a
+     * petty soul is worth 250 and grand and black souls are worth 3000.
+     */
+    int storedSoulValue() const noexcept { return storedSoulValue_; }
+
+    /**
+     * @brief The soul value the soul gems could still hold on top of their
+     * current souls. Black and dual soul gems hold up to 3000.
+     */
+    int freeSoulValue() const noexcept { return freeSoulValue_; }
+
+    /**
+     * @brief Calls fn(soulGemClass, count) for each class of soul gem in the
+     * inventory.
+     */
+    template <typename Fn>
+    void forEachClass(Fn&& fn) const
+    {
+        for (const bool isReusable : {false, true}) {
+            for (SoulGemCapacityValue capacity = SoulGemCapacity::First;
+                 capacity <= SoulGemCapacity::Last;
+                 ++capacity) {
+                for (SoulSizeValue containedSoulSize = SoulSize::First;
+                     containedSoulSize <= SoulSize::Last;
+                     ++containedSoulSize) {
+                    const SoulGemClass soulGemClass{
+                        capacity,
+                        containedSoulSize,
+                        isReusable};
+
+                    if (const auto classCount = count(soulGemClass);
+                        classCount > 0) {
+                        fn(soulGemClass, classCount);
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Equivalent to the inventory status the trap engine computes from
+     * a full inventory scan.
+     */
+    InventoryStatus status() const noexcept;
+
+    /**
+     * @brief Returns an owned soul gem form of the given class, looking only
+     * at the forms listed in the soul gem map for it.
+     *
+     * @returns nullptr if no such soul gem is owned.
+     */
+    RE::TESSoulGem* findSoulGem(
+        const SoulGemMap& soulGemMap,
+        const SoulGemClass& soulGemClass) const;
+};
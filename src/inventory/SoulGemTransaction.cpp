@@ -0,0 +1,211 @@
+#include "SoulGemTransaction.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+
+#include <RE/E/ExtraDataList.h>
+#include <RE/I/InventoryEntryData.h>
+#include <RE/T/TESSoulGem.h>
+
+#include "../global.hpp"
+#include "../formatters/TESSoulGem.hpp"
+#include "../utilities/misc.hpp"
+#include "../utilities/native.hpp"
+
+using namespace std::literals;
+
+namespace {
+    /**
+     * @brief A number of soul gems to replace from one stack in an inventory.
+     */
+    struct StackReplacement_ {
+        RE::TESSoulGem* soulGemToRemove;
+        RE::TESSoulGem* soulGemToAdd;
+        /**
+         * @brief The stack to remove from, or nullptr for soul gems without
+         * extra data.
+         */
+        RE::ExtraDataList* extraList;
+        SoulGemTransaction::Count count;
+    };
+} // namespace
+
+void SoulGemTransaction::replace(
+    RE::TESSoulGem* const soulGemToRemove,
+    RE::TESSoulGem* const soulGemToAdd,
+    const Count count)
+{
+    const auto it = std::find_if(
+        replacements_.begin(),
+        replacements_.end(),
+        [&](const Replacement_& replacement) {
+            return replacement.soulGemToRemove == soulGemToRemove &&
+                   replacement.soulGemToAdd == soulGemToAdd;
+        });
+
+    if (it != replacements_.end()) {
+        it->count += count;
+    } else {
+        replacements_.push_back(
+            Replacement_{soulGemToRemove, soulGemToAdd, count});
+    }
+}
+
+bool SoulGemTransaction::commit(
+    RE::TESObjectREFR* const ref,
+    const bool preserveOwnership)
+{
+    // Split the replacements into stacks before changing the inventory, since
+    // removing items may invalidate them.
+    const auto inventoryMap =
+        getInventoryFor(ref, [](const RE::TESBoundObject& obj) {
+            return obj.IsSoulGem();
+        });
+
+    std::vector<StackReplacement_> stackReplacements;
+    std::unordered_map<RE::ExtraDataList*, Count> takenCounts;
+    std::unordered_map<RE::TESSoulGem*, Count> takenPlainCounts;
+
+    for (const auto& [soulGemToRemove, soulGemToAdd, count] : replacements_) {
+        const auto it = inventoryMap.find(soulGemToRemove);
+        auto remainingCount = count;
+
+        // Soul gems without extra data make up the count not held by any
+        // stack.
+        Count plainCount = it != inventoryMap.end() ? it->second.first : 0;
+        std::vector<RE::ExtraDataList*> extraLists;
+
+        if (const auto entryData =
+                it != inventoryMap.end() ? it->second.second.get() : nullptr;
+            entryData != nullptr && entryData->extraLists != nullptr) {
+            for (const auto extraList : *entryData->extraLists) {
+                if (extraList == nullptr) {
+                    continue;
+                }
+
+                plainCount -= extraList->GetCount();
+
+                // Replacing these would destroy the soul held in the extra
+                // data.
+                if (extraList->GetSoulLevel() == RE::SOUL_LEVEL::kNone) {
+                    extraLists.push_back(extraList);
+                }
+            }
+        }
+
+        const auto takeFromStacks = [&] {
+            for (const auto extraList : extraLists) {
+                auto& takenCount = takenCounts[extraList];
+                const auto stackCount = std::min(
+                    remainingCount,
+                    extraList->GetCount() - takenCount);
+
+                if (stackCount <= 0) {
+                    continue;
+                }
+
+                stackReplacements.push_back(StackReplacement_{
+                    soulGemToRemove,
+                    soulGemToAdd,
+                    extraList,
+                    stackCount});
+                takenCount += stackCount;
+                remainingCount -= stackCount;
+            }
+        };
+
+        const auto takeFromPlainSoulGems = [&] {
+            auto& takenCount = takenPlainCounts[soulGemToRemove];
+            const auto plainTakenCount =
+                std::min(remainingCount, plainCount - takenCount);
+
+            if (plainTakenCount <= 0) {
+                return;
+            }
+
+            stackReplacements.push_back(StackReplacement_{
+                soulGemToRemove,
+                soulGemToAdd,
+                nullptr,
+                plainTakenCount});
+            takenCount += plainTakenCount;
+            remainingCount -= plainTakenCount;
+        };
+
+        // Stacks decide the owner of the soul gems added, so use them first
+        // when preserving ownership.
+        if (preserveOwnership) {
+            takeFromStacks();
+            takeFromPlainSoulGems();
+        } else {
+            takeFromPlainSoulGems();
+            takeFromStacks();
+        }
+
+        if (remainingCount > 0) {
+            LOG_WARN_FMT(
+                "Not enough soul gems without extra souls to replace {} {:f} "
+                "in {}'s inventory. Leaving the inventory unchanged."sv,
+                count,
+                *soulGemToRemove,
+                ref->GetName());
+            replacements_.clear();
+            return false;
+        }
+    }
+
+    replacements_.clear();
+
+    std::vector<RE::TESSoulGem*> addedSoulGems;
+
+    for (const auto& replacement : stackReplacements) {
+        if (replacement.soulGemToAdd == nullptr) {
+            continue;
+        }
+
+        std::unique_ptr<RE::ExtraDataList> newExtraList;
+
+        if (preserveOwnership) {
+            newExtraList =
+                createExtraDataListFromOriginal(replacement.extraList);
+        }
+
+        LOG_TRACE_FMT(
+            "Replacing {} soul gems in {}'s inventory"sv,
+            replacement.count,
+            ref->GetName());
+        LOG_TRACE_FMT("- from: {:f}"sv, *replacement.soulGemToRemove);
+        LOG_TRACE_FMT("- to: {:f}"sv, *replacement.soulGemToAdd);
+
+        ref->AddObjectToContainer(
+            replacement.soulGemToAdd,
+            newExtraList.release(), // Transfer ownership to the engine.
+            replacement.count,
+            nullptr);
+
+        if (std::find(
+                addedSoulGems.begin(),
+                addedSoulGems.end(),
+                replacement.soulGemToAdd) == addedSoulGems.end()) {
+            addedSoulGems.push_back(replacement.soulGemToAdd);
+        }
+    }
+
+    // See consumeReusableSoulGem_() in ChargeItemFix.cpp. This has to happen
+    // before the soul gems are removed.
+    for (const auto soulGem : addedSoulGems) {
+        native::updateInventory(ref, soulGem);
+    }
+
+    for (const auto& replacement : stackReplacements) {
+        ref->RemoveItem(
+            replacement.soulGemToRemove,
+            replacement.count,
+            RE::ITEM_REMOVE_REASON::kRemove,
+            replacement.extraList,
+            nullptr);
+    }
+
+    return true;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <vector>
+
+#include <RE/T/TESObjectREFR.h>
+
+namespace RE {
+    class TESSoulGem;
+} // namespace RE
+
+/**
+ * @brief Collects soul gem replacements in an inventory so that they can be
+ * applied together.
+ *
+ * Replacements of the same soul gem forms are merged, so that each form is
+ * only added to and removed from the inventory once per commit.
+ */
+class SoulGemTransaction {
+public:
+    using Count = RE::TESObjectREFR::Count;
+
+private:
+    struct Replacement_ {
+        RE::TESSoulGem* soulGemToRemove;
+        /**
+         * @brief nullptr if the soul gems are only removed.
+         */
+        RE::TESSoulGem* soulGemToAdd;
+        Count count;
+    };
+
+    std::vector<Replacement_> replacements_;
+
+public:
+    /**
+     * @brief Replaces count soul gems of one form with another. If
+     * soulGemToAdd is nullptr, the soul gems are only removed.
+     */
+    void replace(
+        RE::TESSoulGem* soulGemToRemove,
+        RE::TESSoulGem* soulGemToAdd,
+        Count count = 1);
+
+    [[nodiscard]] bool empty() const noexcept { return replacements_.empty(); }
+
+    /**
+     * @brief Applies the replacements to the inventory of the reference and
+     * clears them.
+     *
+     * Soul gems whose stack holds a soul in its extra data are never removed,
+     * since the soul would be lost. If the replacements can't be applied
+     * without them, nothing is changed.
+     *
+     * With preserveOwnership, soul gems are taken from stacks with extra data
+     * first, and the soul gems added keep the owner of the stack they replace.
+     *
+     * The inventory UI is updated once for each form added.
+     *
+     * @returns Whether the replacements were applied.
+     */
+    bool commit(RE::TESObjectREFR* ref, bool preserveOwnership);
+};
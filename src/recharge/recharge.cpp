@@ -0,0 +1,418 @@
+#include "recharge.hpp"
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+#include <cmath>
+
+#include <RE/A/Actor.h>
+#include <RE/A/ActorValues.h>
+#include <RE/E/ExtraCharge.h>
+#include <RE/E/ExtraDataList.h>
+#include <RE/E/ExtraEnchantment.h>
+#include <RE/I/InventoryChanges.h>
+#include <RE/I/InventoryEntryData.h>
+#include <RE/T/TESObjectWEAP.h>
+#include <RE/T/TESSoulGem.h>
+
+#include "../global.hpp"
+#include "../config/configutilities.hpp"
+#include "../config/ConfigKey/BoolConfigKey.hpp"
+#include "../config/SoulGemMap.hpp"
+#include "../config/YASTMConfig.hpp"
+#include "../formatters/TESSoulGem.hpp"
+#include "../inventory/SoulGemIndex.hpp"
+#include "../inventory/SoulGemTransaction.hpp"
+
+using namespace std::literals;
+
+namespace {
+    /**
+     * @brief Ranks a soul gem class for recharging an item. Lower ranks are
+     * better.
+     */
+    auto rankForRecharge_(
+        const SoulGemClass& soulGemClass,
+        const float missingCharge)
+    {
+        const auto charge = getSoulCharge(soulGemClass.containedSoulSize);
+
+        // The wasted charge if the soul covers the missing charge, or the
+        // charge still missing after recharging otherwise.
+        const auto difference = std::abs(charge - missingCharge);
+
+        return std::make_tuple(
+            charge < missingCharge,
+            difference,
+            soulGemClass.containedSoulSize == SoulSize::Black,
+            !soulGemClass.isReusable,
+            soulGemClass.capacity);
+    }
+
+    /**
+     * @brief An enchanted weapon that is missing charge.
+     */
+    struct RechargeTarget_ {
+        /**
+         * @brief The charge of a weapon in the inventory, or nullptr for an
+         * equipped weapon, whose charge is kept in chargeValue instead.
+         */
+        RE::ExtraCharge* extraCharge;
+        RE::ActorValue chargeValue;
+        float maxCharge;
+        float missingCharge;
+    };
+
+    /**
+     * @brief A soul gem planned to recharge a target with.
+     */
+    struct RechargeStep_ {
+        RechargeTarget_ target;
+        RE::TESSoulGem* soulGem;
+        SoulGemClass soulGemClass;
+    };
+
+    [[nodiscard]] std::optional<RechargeTarget_> getEquippedRechargeTarget_(
+        RE::Actor* const actor,
+        const bool isLeftHand)
+    {
+        const auto chargeValue = isLeftHand ? RE::ActorValue::kLeftItemCharge
+                                            : RE::ActorValue::kRightItemCharge;
+
+        // The permanent value is the maximum charge of the equipped weapon, or
+        // 0 if it's not enchanted.
+        const float maxCharge = actor->GetPermanentActorValue(chargeValue);
+        const float missingCharge =
+            maxCharge - actor->GetActorValue(chargeValue);
+
+        if (missingCharge <= 0) {
+            return std::nullopt;
+        }
+
+        return RechargeTarget_{nullptr, chargeValue, maxCharge, missingCharge};
+    }
+
+    [[nodiscard]] float getMaxCharge_(
+        RE::TESObjectWEAP* const weapon,
+        RE::ExtraDataList* const extraList)
+    {
+        // Weapons enchanted by the player keep their enchantment in the extra
+        // data.
+        if (const auto extraEnchantment =
+                extraList->GetByType<RE::ExtraEnchantment>();
+            extraEnchantment != nullptr &&
+            extraEnchantment->enchantment != nullptr) {
+            return extraEnchantment->charge;
+        }
+
+        if (weapon->formEnchanting != nullptr) {
+            return weapon->amountofEnchantment;
+        }
+
+        return 0;
+    }
+
+    /**
+     * @brief Returns the enchanted weapons of the actor that are missing
+     * charge, equipped or not.
+     */
+    [[nodiscard]] std::vector<RechargeTarget_>
+        getRechargeTargets_(RE::Actor* const actor)
+    {
+        std::vector<RechargeTarget_> targets;
+
+        for (const bool isLeftHand : {false, true}) {
+            if (const auto target =
+                    getEquippedRechargeTarget_(actor, isLeftHand);
+                target.has_value()) {
+                targets.push_back(*target);
+            }
+        }
+
+        const auto inventoryChanges = actor->GetInventoryChanges();
+
+        if (inventoryChanges == nullptr ||
+            inventoryChanges->entryList == nullptr) {
+            return targets;
+        }
+
+        for (const auto entryData : *inventoryChanges->entryList) {
+            if (entryData == nullptr || entryData->object == nullptr ||
+                entryData->extraLists == nullptr ||
+                !entryData->object->IsWeapon()) {
+                continue;
+            }
+
+            const auto weapon = entryData->object->As<RE::TESObjectWEAP>();
+
+            for (const auto extraList : *entryData->extraLists) {
+                // Weapons without charge extra data are fully charged.
+                // Equipped weapons were handled above.
+                if (extraList == nullptr ||
+                    extraList->HasType(RE::ExtraDataType::kWorn) ||
+                    extraList->HasType(RE::ExtraDataType::kWornLeft)) {
+                    continue;
+                }
+
+                const auto extraCharge =
+                    extraList->GetByType<RE::ExtraCharge>();
+
+                if (extraCharge == nullptr) {
+                    continue;
+                }
+
+                const float maxCharge = getMaxCharge_(weapon, extraList);
+                const float missingCharge = maxCharge - extraCharge->charge;
+
+                if (missingCharge > 0) {
+                    targets.push_back(RechargeTarget_{
+                        extraCharge,
+                        RE::ActorValue::kNone,
+                        maxCharge,
+                        missingCharge});
+                }
+            }
+        }
+
+        return targets;
+    }
+
+    /**
+     * @brief Picks a soul gem from the inventory for each target, removing it
+     * from the inventory as it goes.
+     *
+     * Targets missing the most charge are planned first, so that they get the
+     * largest souls. Planning stops once the inventory runs out of filled soul
+     * gems.
+     */
+    [[nodiscard]] std::vector<RechargeStep_> planRecharge_(
+        std::vector<RechargeTarget_> targets,
+        SoulGemInventory& inventory,
+        const SoulGemMap& soulGemMap)
+    {
+        std::vector<RechargeStep_> steps;
+
+        std::stable_sort(
+            targets.begin(),
+            targets.end(),
+            [](const RechargeTarget_& lhs, const RechargeTarget_& rhs) {
+                return lhs.missingCharge > rhs.missingCharge;
+            });
+
+        for (const auto& target : targets) {
+            while (true) {
+                const auto soulGemClass =
+                    selectRechargeSoulGemClass(inventory, target.missingCharge);
+
+                if (!soulGemClass.has_value()) {
+                    return steps;
+                }
+
+                const auto soulGem =
+                    inventory.findSoulGem(soulGemMap, *soulGemClass);
+
+                if (soulGem == nullptr) {
+                    return steps;
+                }
+
+                // Leave out reusable soul gems that can't be emptied, and pick
+                // again.
+                if (soulGemClass->isReusable &&
+                    getSoulGemBaseForm(soulGem, soulGemMap) == nullptr) {
+                    LOG_ERROR_FMT(
+                        "Cannot find base form for soul gem {}. Soul gem will "
+                        "not be used."sv,
+                        *soulGem);
+                    inventory.add(
+                        soulGem,
+                        *soulGemClass,
+                        -inventory.countOf(soulGem));
+                    continue;
+                }
+
+                inventory.add(soulGem, *soulGemClass, -1);
+                steps.push_back(RechargeStep_{target, soulGem, *soulGemClass});
+                break;
+            }
+        }
+
+        return steps;
+    }
+
+    /**
+     * @brief Consumes the soul gems used by the steps from the actor's
+     * inventory. Reusable soul gems are replaced with their empty version
+     * instead.
+     *
+     * @returns false if the soul gems could not be consumed.
+     */
+    [[nodiscard]] bool consumeSoulGems_(
+        RE::Actor* const actor,
+        const std::vector<RechargeStep_>& steps,
+        const SoulGemMap& soulGemMap)
+    {
+        const auto& config = YASTMConfig::getInstance();
+        SoulGemTransaction transaction;
+
+        for (const auto& step : steps) {
+            transaction.replace(
+                step.soulGem,
+                step.soulGemClass.isReusable
+                    ? getSoulGemBaseForm(step.soulGem, soulGemMap)
+                    : nullptr);
+        }
+
+        return transaction.commit(
+            actor,
+            config.getGlobalBool(BoolConfigKey::PreserveOwnership));
+    }
+
+    /**
+     * @brief Consumes the soul gems used by the steps, then recharges their
+     * targets.
+     *
+     * @returns false if the soul gems could not be consumed, in which case
+     * nothing is recharged.
+     */
+    [[nodiscard]] bool applyRecharge_(
+        RE::Actor* const actor,
+        const std::vector<RechargeStep_>& steps,
+        const SoulGemMap& soulGemMap)
+    {
+        if (!consumeSoulGems_(actor, steps, soulGemMap)) {
+            return false;
+        }
+
+        for (const auto& [target, soulGem, soulGemClass] : steps) {
+            const auto charge = std::min(
+                getSoulCharge(soulGemClass.containedSoulSize),
+                target.missingCharge);
+
+            LOG_TRACE_FMT("Recharging item with {}"sv, *soulGem);
+
+            if (target.extraCharge != nullptr) {
+                target.extraCharge->charge = std::min(
+                    target.extraCharge->charge + charge,
+                    target.maxCharge);
+            } else {
+                actor->RestoreActorValue(
+                    RE::ACTOR_VALUE_MODIFIER::kDamage,
+                    target.chargeValue,
+                    charge);
+            }
+        }
+
+        return true;
+    }
+} // namespace
+
+std::optional<SoulGemClass> selectRechargeSoulGemClass(
+    const SoulGemInventory& inventory,
+    const float missingCharge)
+{
+    std::optional<SoulGemClass> bestClass;
+
+    inventory.forEachClass([&](const SoulGemClass& soulGemClass, auto) {
+        if (soulGemClass.containedSoulSize == SoulSize::None) {
+            return;
+        }
+
+        if (!bestClass.has_value() ||
+            rankForRecharge_(soulGemClass, missingCharge) <
+                rankForRecharge_(*bestClass, missingCharge)) {
+            bestClass = soulGemClass;
+        }
+    });
+
+    return bestClass;
+}
+
+RE::TESSoulGem*
+    findRechargeSoulGem(RE::Actor* const actor, const float missingCharge)
+{
+    const auto& config = YASTMConfig::getInstance();
+
+    if (!config.isReady()) {
+        LOG_WARN("Configuration is not loaded. Skipping recharge."sv);
+        return nullptr;
+    }
+
+    const auto inventory = SoulGemIndex::getInstance().get(actor);
+    const auto soulGemClass =
+        selectRechargeSoulGemClass(*inventory, missingCharge);
+
+    if (!soulGemClass.has_value()) {
+        return nullptr;
+    }
+
+    return inventory->findSoulGem(getSoulGemMap(config), *soulGemClass);
+}
+
+RE::TESSoulGem*
+    rechargeEquippedWeapon(RE::Actor* const actor, const bool isLeftHand)
+{
+    const auto& config = YASTMConfig::getInstance();
+
+    if (!config.isReady()) {
+        LOG_WARN("Configuration is not loaded. Skipping recharge."sv);
+        return nullptr;
+    }
+
+    const auto target = getEquippedRechargeTarget_(actor, isLeftHand);
+
+    if (!target.has_value()) {
+        LOG_TRACE("Equipped weapon does not need recharging."sv);
+        return nullptr;
+    }
+
+    const auto& soulGemMap = getSoulGemMap(config);
+    auto inventory = *SoulGemIndex::getInstance().get(actor);
+    const auto steps = planRecharge_({*target}, inventory, soulGemMap);
+
+    if (steps.empty()) {
+        LOG_TRACE("No soul gem to recharge the equipped weapon with."sv);
+        return nullptr;
+    }
+
+    if (!applyRecharge_(actor, steps, soulGemMap)) {
+        return nullptr;
+    }
+
+    return steps.front().soulGem;
+}
+
+RechargeAllResult rechargeAll(RE::Actor* const actor)
+{
+    const auto& config = YASTMConfig::getInstance();
+
+    if (!config.isReady()) {
+        LOG_WARN("Configuration is not loaded. Skipping recharge."sv);
+        return {};
+    }
+
+    const auto& soulGemMap = getSoulGemMap(config);
+    const auto targets = getRechargeTargets_(actor);
+
+    if (targets.empty()) {
+        LOG_TRACE("No items need recharging."sv);
+        return {};
+    }
+
+    // Plan on a copy, so that each soul gem is only planned once.
+    auto inventory = *SoulGemIndex::getInstance().get(actor);
+    const auto steps = planRecharge_(targets, inventory, soulGemMap);
+
+    LOG_TRACE_FMT(
+        "Recharging {} of {} items missing charge."sv,
+        steps.size(),
+        targets.size());
+
+    if (!applyRecharge_(actor, steps, soulGemMap)) {
+        return RechargeAllResult{0, static_cast<int>(targets.size())};
+    }
+
+    return RechargeAllResult{
+        static_cast<int>(steps.size()),
+        static_cast<int>(targets.size())};
+}
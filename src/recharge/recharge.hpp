@@ -0,0 +1,74 @@
+#pragma once
+
+#include <optional>
+
+#include "../inventory/SoulGemInventory.hpp"
+
+namespace RE {
+    class Actor;
+    class TESSoulGem;
+} // namespace RE
+
+/**
+ * @brief Returns the charge a soul of the given size restores.
+ */
+[[nodiscard]] constexpr float getSoulCharge(const SoulSize soulSize)
+{
+    return static_cast<float>(toSoulLevelValue(soulSize));
+}
+
+/**
+ * @brief Picks the class of filled soul gem to recharge an item with.
+ *
+ * Among the soul gems covering the missing charge, this picks the one wasting
+ * the least charge. If none covers it, this picks the largest soul. Ties favor
+ * white souls over black souls, then reusable soul gems, then smaller soul
+ * gems.
+ *
+ * This only looks at the counts of each class, so it takes the same time
+ * regardless of the inventory size.
+ *
+ * @returns std::nullopt if the inventory has no filled soul gems.
+ */
+[[nodiscard]] std::optional<SoulGemClass> selectRechargeSoulGemClass(
+    const SoulGemInventory& inventory,
+    float missingCharge);
+
+/**
+ * @brief Returns the filled soul gem owned by the actor that best covers the
+ * missing charge (see selectRechargeSoulGemClass()).
+ *
+ * @returns nullptr if the actor owns no filled soul gems.
+ */
+[[nodiscard]] RE::TESSoulGem*
+    findRechargeSoulGem(RE::Actor* actor, float missingCharge);
+
+/**
+ * @brief Recharges the enchanted weapon the actor has equipped in the given
+ * hand with the soul gem returned by findRechargeSoulGem().
+ *
+ * Reusable soul gems are emptied instead of consumed, keeping their owner if
+ * PreserveOwnership is enabled.
+ *
+ * @returns The soul gem used, or nullptr if nothing was recharged.
+ */
+RE::TESSoulGem* rechargeEquippedWeapon(RE::Actor* actor, bool isLeftHand);
+
+/**
+ * @brief The result of rechargeAll().
+ */
+struct RechargeAllResult {
+    int rechargedItemCount = 0;
+    int itemsMissingChargeCount = 0;
+};
+
+/**
+ * @brief Recharges every enchanted weapon of the actor that is missing charge,
+ * equipped or not.
+ *
+ * The soul gems are planned up front, picking them as
+ * selectRechargeSoulGemClass() does, with the items missing the most charge
+ * going first. The soul gems used are then consumed together, so that each
+ * soul gem form is only added to and removed from the inventory once.
+ */
+RechargeAllResult rechargeAll(RE::Actor* actor);
@@ -0,0 +1,250 @@
+#include "NotificationThrottle.hpp"
+
+#include <utility>
+
+#include <SKSE/SKSE.h>
+#include <RE/M/Misc.h>
+#include <RE/S/SoulsTrapped.h>
+#include <RE/T/TESForm.h>
+
+#include <fmt/format.h>
+
+#include "../global.hpp"
+
+using namespace std::literals;
+
+std::string NotificationThrottle::SoulTrapSummary_::format() const
+{
+    return fmt::format(
+        fmt::runtime(getMessage(MiscMessage::SoulTrapSummary)),
+        capturedCount,
+        displacedCount,
+        shrunkCount,
+        splitCount,
+        heldCount,
+        failedCount);
+}
+
+void NotificationThrottle::SoulTrapSummary_::send() const
+{
+    const auto message = format();
+
+    LOG_TRACE_FMT("Showing notification summary: {}"sv, message);
+    RE::DebugNotification(message.c_str());
+}
+
+std::string NotificationThrottle::ProfilingSummary_::format() const
+{
+    return fmt::format(
+        fmt::runtime(getMessage(MiscMessage::TimeTakenToTrapSouls)),
+        count,
+        elapsedTime);
+}
+
+void NotificationThrottle::ProfilingSummary_::send() const
+{
+    const auto message = format();
+
+    LOG_TRACE_FMT("Showing notification summary: {}"sv, message);
+    RE::DebugNotification(message.c_str());
+}
+
+void NotificationThrottle::SoulTrapEventSummary_::send() const
+{
+    LOG_TRACE_FMT(
+        "Sending {} for {} held back SoulsTrapped events."sv,
+        SoulsTrappedEventName,
+        count);
+
+    // The name is a literal, so it's null-terminated.
+    SKSE::ModCallbackEvent event{
+        SoulsTrappedEventName.data(),
+        "",
+        static_cast<float>(count),
+        RE::TESForm::LookupByID<RE::Actor>(lastCasterId)};
+
+    SKSE::GetModCallbackEventSource()->SendEvent(&event);
+}
+
+template <typename Summary, typename Fn>
+void NotificationThrottle::notify_(
+    Window_<Summary> NotificationThrottle::*const window,
+    const Duration windowLength,
+    const std::string& message,
+    Fn&& addToSummary)
+{
+    if (windowLength <= Duration::zero()) {
+        RE::DebugNotification(message.c_str());
+        return;
+    }
+
+    std::lock_guard lock(mutex_);
+
+    auto& w = this->*window;
+
+    if (w.closeTime.has_value()) {
+        addToSummary(w.summary);
+        return;
+    }
+
+    RE::DebugNotification(message.c_str());
+    w.length = windowLength;
+    openWindow_(w, Clock_::now());
+}
+
+template <typename Summary>
+void NotificationThrottle::openWindow_(
+    Window_<Summary>& window,
+    const Clock_::time_point now)
+{
+    window.closeTime = now + window.length;
+    scheduleTick_();
+}
+
+template <typename Summary>
+bool NotificationThrottle::closeWindowIfDue_(
+    Window_<Summary>& window,
+    const Clock_::time_point now)
+{
+    if (!window.closeTime.has_value()) {
+        return false;
+    }
+
+    if (now < *window.closeTime) {
+        return true;
+    }
+
+    if (window.summary.empty()) {
+        window.closeTime.reset();
+        return false;
+    }
+
+    window.summary.send();
+    window.summary = Summary{};
+
+    // Keep merging notifications for as long as they keep coming.
+    openWindow_(window, now);
+
+    return true;
+}
+
+void NotificationThrottle::scheduleTick_()
+{
+    if (isTickScheduled_) {
+        return;
+    }
+
+    isTickScheduled_ = true;
+
+    // A task added while the main thread runs its tasks would run in the same
+    // frame, so hop through the UI task queue to land on the next one.
+    // Notifications are shown from the main thread, like the ones the game
+    // shows.
+    SKSE::GetTaskInterface()->AddUITask([]() {
+        SKSE::GetTaskInterface()->AddTask(
+            []() { NotificationThrottle::getInstance().tick_(); });
+    });
+}
+
+void NotificationThrottle::tick_()
+{
+    std::lock_guard lock(mutex_);
+
+    isTickScheduled_ = false;
+
+    const auto now = Clock_::now();
+    const bool isSoulTrapWindowOpen = closeWindowIfDue_(soulTrapWindow_, now);
+    const bool isProfilingWindowOpen =
+        closeWindowIfDue_(profilingWindow_, now);
+    const bool isSoulTrapEventWindowOpen =
+        closeWindowIfDue_(soulTrapEventWindow_, now);
+
+    if (isSoulTrapWindowOpen || isProfilingWindowOpen ||
+        isSoulTrapEventWindowOpen) {
+        scheduleTick_();
+    }
+}
+
+void NotificationThrottle::notifySoulTrapSuccess(
+    const SoulTrapSuccessMessage message,
+    const bool isDegraded,
+    const Duration windowLength)
+{
+    notify_(
+        &NotificationThrottle::soulTrapWindow_,
+        windowLength,
+        getMessage(message, isDegraded),
+        [message](SoulTrapSummary_& summary) {
+            ++summary.capturedCount;
+
+            switch (message) {
+            case SoulTrapSuccessMessage::SoulCaptured:
+                break;
+            case SoulTrapSuccessMessage::SoulDisplaced:
+                ++summary.displacedCount;
+                break;
+            case SoulTrapSuccessMessage::SoulShrunk:
+                ++summary.shrunkCount;
+                break;
+            case SoulTrapSuccessMessage::SoulSplit:
+                ++summary.splitCount;
+                break;
+            }
+        });
+}
+
+void NotificationThrottle::notifySoulTrapFailure(
+    const SoulTrapFailureMessage message,
+    const Duration windowLength)
+{
+    notify_(
+        &NotificationThrottle::soulTrapWindow_,
+        windowLength,
+        getMessage(message),
+        [message](SoulTrapSummary_& summary) {
+            if (message == SoulTrapFailureMessage::SoulHeld) {
+                ++summary.heldCount;
+            } else {
+                ++summary.failedCount;
+            }
+        });
+}
+
+void NotificationThrottle::notifyTimeTakenToTrapSoul(
+    const double elapsedTime,
+    const Duration windowLength)
+{
+    notify_(
+        &NotificationThrottle::profilingWindow_,
+        windowLength,
+        fmt::format(
+            fmt::runtime(getMessage(MiscMessage::TimeTakenToTrapSoul)),
+            elapsedTime),
+        [elapsedTime](ProfilingSummary_& summary) {
+            ++summary.count;
+            summary.elapsedTime += elapsedTime;
+        });
+}
+
+void NotificationThrottle::sendSoulTrapEvent(
+    RE::Actor* const caster,
+    RE::Actor* const victim,
+    const Duration windowLength)
+{
+    if (windowLength > Duration::zero()) {
+        std::lock_guard lock(mutex_);
+
+        auto& window = soulTrapEventWindow_;
+
+        if (window.closeTime.has_value()) {
+            ++window.summary.count;
+            window.summary.lastCasterId = caster->GetFormID();
+            return;
+        }
+
+        window.length = windowLength;
+        openWindow_(window, Clock_::now());
+    }
+
+    RE::SoulsTrapped::SendEvent(caster, victim);
+}
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <RE/A/Actor.h>
+
+#include "../messages.hpp"
+
+/**
+ * @brief Limits the soul trap notifications shown to the player and the
+ * SoulsTrapped events sent to other mods when many souls are trapped in a
+ * short time.
+ *
+ * The first notification is shown immediately and opens a window. The
+ * notifications requested while the window is open are merged into a summary
+ * (see MiscMessage::SoulTrapSummary) shown when it closes, which opens a new
+ * window if there was anything to show.
+ *
+ * Windows are closed on the main thread by a task that runs once per frame
+ * while any window is open, so a window closes on the first frame after its
+ * length has passed.
+ *
+ * Soul trap and profiling notifications have separate windows, so that the
+ * soul trap notification doesn't delay the time taken to trap it.
+ *
+ * SoulsTrapped events have their own window. The first event is sent
+ * immediately, and the events of the souls trapped while the window is open
+ * are held back. When the window closes, a single SoulsTrappedEventName mod
+ * event carries the number of events held back, since the game's event can
+ * only name one victim.
+ */
+class NotificationThrottle {
+public:
+    using Duration = std::chrono::milliseconds;
+
+    /**
+     * @brief The mod event sent when a SoulsTrapped event window closes.
+     * numArg is the number of SoulsTrapped events held back in the window,
+     * and sender is the last caster whose event was held back.
+     */
+    static constexpr std::string_view SoulsTrappedEventName =
+        "YASTM_SoulsTrapped";
+
+private:
+    using Clock_ = std::chrono::steady_clock;
+
+    struct SoulTrapSummary_ {
+        int capturedCount = 0;
+        int displacedCount = 0;
+        int shrunkCount = 0;
+        int splitCount = 0;
+        int heldCount = 0;
+        int failedCount = 0;
+
+        bool empty() const noexcept
+        {
+            return capturedCount == 0 && heldCount == 0 && failedCount == 0;
+        }
+
+        std::string format() const;
+        void send() const;
+    };
+
+    struct ProfilingSummary_ {
+        int count = 0;
+        double elapsedTime = 0.0;
+
+        bool empty() const noexcept { return count == 0; }
+
+        std::string format() const;
+        void send() const;
+    };
+
+    struct SoulTrapEventSummary_ {
+        int count = 0;
+        RE::FormID lastCasterId = 0;
+
+        bool empty() const noexcept { return count == 0; }
+
+        void send() const;
+    };
+
+    template <typename Summary>
+    struct Window_ {
+        /**
+         * @brief When the window closes, or nullopt if it isn't open.
+         */
+        std::optional<Clock_::time_point> closeTime;
+        Duration length{};
+        Summary summary;
+    };
+
+    Window_<SoulTrapSummary_> soulTrapWindow_;
+    Window_<ProfilingSummary_> profilingWindow_;
+    Window_<SoulTrapEventSummary_> soulTrapEventWindow_;
+    bool isTickScheduled_ = false;
+    std::mutex mutex_;
+
+    explicit NotificationThrottle() = default;
+
+    /**
+     * @brief Shows the message if the window isn't open and opens it.
+     * Otherwise, calls addToSummary(summary) instead.
+     */
+    template <typename Summary, typename Fn>
+    void notify_(
+        Window_<Summary> NotificationThrottle::*window,
+        Duration windowLength,
+        const std::string& message,
+        Fn&& addToSummary);
+
+    template <typename Summary>
+    void openWindow_(Window_<Summary>& window, Clock_::time_point now);
+
+    /**
+     * @brief Sends the window's summary if its length has passed, then
+     * reopens it if there was anything to send or closes it otherwise.
+     *
+     * @returns True if the window is still open.
+     */
+    template <typename Summary>
+    bool closeWindowIfDue_(Window_<Summary>& window, Clock_::time_point now);
+
+    /**
+     * @brief Schedules tick_() for the next frame if it isn't already.
+     */
+    void scheduleTick_();
+    void tick_();
+
+public:
+    [[nodiscard]] static NotificationThrottle& getInstance()
+    {
+        static NotificationThrottle instance;
+        return instance;
+    }
+
+    NotificationThrottle(const NotificationThrottle&) = delete;
+    NotificationThrottle(NotificationThrottle&&) = delete;
+    NotificationThrottle& operator=(const NotificationThrottle&) = delete;
+    NotificationThrottle& operator=(NotificationThrottle&&) = delete;
+
+    /**
+     * @brief Shows the soul trap success message, or counts it in the summary.
+     * A window length of zero shows every message.
+     */
+    void notifySoulTrapSuccess(
+        SoulTrapSuccessMessage message,
+        bool isDegraded,
+        Duration windowLength);
+
+    /**
+     * @brief Shows the soul trap failure message, or counts it in the summary.
+     * A window length of zero shows every message.
+     */
+    void notifySoulTrapFailure(
+        SoulTrapFailureMessage message,
+        Duration windowLength);
+
+    /**
+     * @brief Shows the time taken to trap a soul, or adds it to the total
+     * shown in the summary. A window length of zero shows every message.
+     */
+    void notifyTimeTakenToTrapSoul(double elapsedTime, Duration windowLength);
+
+    /**
+     * @brief Sends the SoulsTrapped event, or counts it for the
+     * SoulsTrappedEventName event sent when the window closes. A window
+     * length of zero sends every event.
+     */
+    void sendSoulTrapEvent(
+        RE::Actor* caster,
+        RE::Actor* victim,
+        Duration windowLength);
+};
@@ -0,0 +1,228 @@
+#include "PendingSoulBacklog.hpp"
+
+#include <algorithm>
+
+#include <SKSE/SKSE.h>
+#include <RE/A/Actor.h>
+#include <RE/S/ScriptEventSourceHolder.h>
+#include <RE/T/TESForm.h>
+#include <RE/T/TESSoulGem.h>
+
+#include "trapsoul.hpp"
+#include "../global.hpp"
+#include "../SoulValue.hpp"
+#include "../inventory/SoulGemIndex.hpp"
+
+using namespace std::literals;
+
+void PendingSoulBacklog::Backlog_::prune(const Clock::time_point now)
+{
+    for (auto& soulsOfSize : souls) {
+        while (!soulsOfSize.empty() && soulsOfSize.front().expiryTime <= now) {
+            soulsOfSize.pop_front();
+            --count;
+        }
+    }
+}
+
+void PendingSoulBacklog::Backlog_::insert(const PendingSoul& soul)
+{
+    auto& soulsOfSize = souls[soul.soulSize];
+
+    soulsOfSize.insert(
+        std::upper_bound(
+            soulsOfSize.begin(),
+            soulsOfSize.end(),
+            soul,
+            [](const PendingSoul& lhs, const PendingSoul& rhs) {
+                return lhs.expiryTime < rhs.expiryTime;
+            }),
+        soul);
+    ++count;
+}
+
+void PendingSoulBacklog::initialize()
+{
+    clear();
+
+    if (const auto eventSource = RE::ScriptEventSourceHolder::GetSingleton();
+        eventSource != nullptr) {
+        eventSource->AddEventSink<RE::TESContainerChangedEvent>(this);
+    } else {
+        LOG_ERROR("Could not listen to container change events."sv);
+    }
+}
+
+void PendingSoulBacklog::clear()
+{
+    std::lock_guard lock(mutex_);
+
+    backlogs_.clear();
+}
+
+bool PendingSoulBacklog::add(
+    RE::Actor* const caster,
+    RE::Actor* const victim,
+    const SoulSize soulSize,
+    const std::size_t limit,
+    const Duration lifetime)
+{
+    if (limit == 0) {
+        return false;
+    }
+
+    const auto now = Clock::now();
+
+    std::lock_guard lock(mutex_);
+
+    auto& backlog = backlogs_[caster->GetFormID()];
+
+    backlog.prune(now);
+
+    if (backlog.count >= limit) {
+        for (SoulSizeValue smallerSoulSize = SoulSize::First;
+             smallerSoulSize < soulSize;
+             ++smallerSoulSize) {
+            if (auto& soulsOfSize = backlog.souls[smallerSoulSize];
+                !soulsOfSize.empty()) {
+                LOG_TRACE_FMT(
+                    "Dropping pending {} soul to make room."sv,
+                    smallerSoulSize);
+                soulsOfSize.pop_front();
+                --backlog.count;
+                break;
+            }
+        }
+
+        if (backlog.count >= limit) {
+            LOG_TRACE("Pending soul backlog is full. Dropping soul."sv);
+            return false;
+        }
+    }
+
+    backlog.insert(
+        PendingSoul{soulSize, victim->GetFormID(), now + lifetime});
+
+    LOG_TRACE_FMT(
+        "Added pending {} soul for {} ({} pending)."sv,
+        soulSize,
+        caster->GetName(),
+        backlog.count);
+
+    return true;
+}
+
+std::vector<PendingSoulBacklog::PendingSoul>
+    PendingSoulBacklog::take(RE::Actor* const caster)
+{
+    std::lock_guard lock(mutex_);
+
+    const auto it = backlogs_.find(caster->GetFormID());
+
+    if (it == backlogs_.end()) {
+        return {};
+    }
+
+    auto& backlog = it->second;
+    std::vector<PendingSoul> souls;
+
+    backlog.prune(Clock::now());
+    souls.reserve(backlog.count);
+
+    for (SoulSizeValue soulSize = SoulSize::Last; soulSize > SoulSize::None;
+         --soulSize) {
+        const auto& soulsOfSize = backlog.souls[soulSize];
+
+        souls.insert(souls.end(), soulsOfSize.begin(), soulsOfSize.end());
+    }
+
+    backlogs_.erase(it);
+
+    return souls;
+}
+
+void PendingSoulBacklog::restore(
+    RE::Actor* const caster,
+    const std::vector<PendingSoul>& souls)
+{
+    if (souls.empty()) {
+        return;
+    }
+
+    std::lock_guard lock(mutex_);
+
+    // Trapping souls is serialized, so no souls were added since these were
+    // taken, and putting them back can't go over the limit.
+    auto& backlog = backlogs_[caster->GetFormID()];
+
+    for (const auto& soul : souls) {
+        backlog.insert(soul);
+    }
+
+    backlog.prune(Clock::now());
+
+    LOG_TRACE_FMT(
+        "Restored {} pending souls for {}."sv,
+        backlog.count,
+        caster->GetName());
+}
+
+RE::BSEventNotifyControl PendingSoulBacklog::ProcessEvent(
+    const RE::TESContainerChangedEvent* const event,
+    RE::BSTEventSource<RE::TESContainerChangedEvent>*)
+{
+    if (event == nullptr || event->newContainer == 0 ||
+        event->itemCount <= 0) {
+        return RE::BSEventNotifyControl::kContinue;
+    }
+
+    const auto soulGem =
+        RE::TESForm::LookupByID<RE::TESSoulGem>(event->baseObj);
+
+    if (soulGem == nullptr) {
+        return RE::BSEventNotifyControl::kContinue;
+    }
+
+    const auto soulGemClass = SoulGemIndex::getInstance().classify(soulGem);
+
+    // Dual soul gems are full with either a white grand or a black soul.
+    if (soulGemClass == nullptr ||
+        soulGemClass->containedSoulSize >=
+            toSoulSize(soulGemClass->capacity)) {
+        return RE::BSEventNotifyControl::kContinue;
+    }
+
+    {
+        std::lock_guard lock(mutex_);
+
+        const auto it = backlogs_.find(event->newContainer);
+
+        if (it == backlogs_.end() || it->second.isTrapScheduled) {
+            return RE::BSEventNotifyControl::kContinue;
+        }
+
+        it->second.isTrapScheduled = true;
+    }
+
+    // Trapping souls changes the inventory, so don't do it while its events
+    // are being sent.
+    SKSE::GetTaskInterface()->AddTask(
+        [this, casterId = event->newContainer]() {
+            const auto caster = RE::TESForm::LookupByID<RE::Actor>(casterId);
+
+            if (caster != nullptr) {
+                trapPendingSouls(caster);
+                return;
+            }
+
+            // Let the next soul gem added to this container try again.
+            std::lock_guard lock(mutex_);
+
+            if (const auto it = backlogs_.find(casterId);
+                it != backlogs_.end()) {
+                it->second.isTrapScheduled = false;
+            }
+        });
+
+    return RE::BSEventNotifyControl::kContinue;
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <RE/B/BSTEvent.h>
+#include <RE/F/FormTypes.h>
+#include <RE/T/TESContainerChangedEvent.h>
+
+#include "../SoulSize.hpp"
+#include "../utilities/EnumArray.hpp"
+
+namespace RE {
+    class Actor;
+} // namespace RE
+
+/**
+ * @brief Keeps the souls that couldn't be trapped because the caster had no
+ * soul gems to fill, so that they can be trapped once the caster gets one.
+ *
+ * A caster's pending souls are trapped in a single pass when a soul gem that
+ * isn't fully filled is added to their inventory, e.g. when it's picked up or
+ * when a reusable soul gem is emptied. Souls that still don't fit stay in the
+ * backlog, so a soul is only dropped when it expires or when a larger soul
+ * needs its place.
+ */
+class PendingSoulBacklog
+    : public RE::BSTEventSink<RE::TESContainerChangedEvent> {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Duration = std::chrono::seconds;
+
+    struct PendingSoul {
+        SoulSize soulSize;
+        /**
+         * @brief The actor the soul was taken from. Used to report the soul
+         * trap once the soul is trapped.
+         */
+        RE::FormID victimId;
+        Clock::time_point expiryTime;
+    };
+
+private:
+    struct Backlog_ {
+        /**
+         * @brief The pending souls of each size, oldest first.
+         */
+        EnumArray<SoulSize, std::deque<PendingSoul>> souls;
+        std::size_t count = 0;
+        bool isTrapScheduled = false;
+
+        /**
+         * @brief Removes the souls that expired.
+         */
+        void prune(Clock::time_point now);
+        /**
+         * @brief Adds the soul, keeping each size ordered by expiry time.
+         */
+        void insert(const PendingSoul& soul);
+    };
+
+    std::unordered_map<RE::FormID, Backlog_> backlogs_;
+    std::mutex mutex_;
+
+    explicit PendingSoulBacklog() = default;
+
+public:
+    [[nodiscard]] static PendingSoulBacklog& getInstance()
+    {
+        static PendingSoulBacklog instance;
+        return instance;
+    }
+
+    PendingSoulBacklog(const PendingSoulBacklog&) = delete;
+    PendingSoulBacklog(PendingSoulBacklog&&) = delete;
+    PendingSoulBacklog& operator=(const PendingSoulBacklog&) = delete;
+    PendingSoulBacklog& operator=(PendingSoulBacklog&&) = delete;
+
+    /**
+     * @brief Starts listening to container change events. Call once the soul
+     * gem index is initialized.
+     */
+    void initialize();
+
+    /**
+     * @brief Forgets all pending souls. Called when a game is loaded, since
+     * they belong to the previous game.
+     */
+    void clear();
+
+    /**
+     * @brief Adds a soul to the caster's backlog, which expires after the
+     * given lifetime.
+     *
+     * If the backlog already holds limit souls, the oldest of the smallest
+     * souls is dropped to make room, unless the new soul is no larger.
+     *
+     * @returns False if the soul was dropped instead.
+     */
+    bool add(
+        RE::Actor* caster,
+        RE::Actor* victim,
+        SoulSize soulSize,
+        std::size_t limit,
+        Duration lifetime);
+
+    /**
+     * @brief Removes the caster's pending souls that haven't expired and
+     * returns them, largest first.
+     */
+    std::vector<PendingSoul> take(RE::Actor* caster);
+
+    /**
+     * @brief Returns souls taken with take() that couldn't be trapped to the
+     * caster's backlog. They keep their expiry times.
+     */
+    void restore(RE::Actor* caster, const std::vector<PendingSoul>& souls);
+
+    RE::BSEventNotifyControl ProcessEvent(
+        const RE::TESContainerChangedEvent* event,
+        RE::BSTEventSource<RE::TESContainerChangedEvent>* source) override;
+};
@@ -0,0 +1,133 @@
+#include "SoulDiversion.hpp"
+
+#include <compare>
+#include <optional>
+#include <vector>
+
+#include <RE/A/Actor.h>
+#include <RE/P/PlayerCharacter.h>
+#include <RE/P/ProcessLists.h>
+
+#include "InventoryStatus.hpp"
+#include "../global.hpp"
+#include "../config/ConfigKey/BoolConfigKey.hpp"
+#include "../config/YASTMConfig.hpp"
+#include "../inventory/SoulGemIndex.hpp"
+#include "../utilities/misc.hpp"
+
+using namespace std::literals;
+
+namespace {
+    /**
+     * @brief How well the soul gems of an inventory fit a soul. Lower is
+     * better.
+     */
+    struct SoulFit_ {
+        /**
+         * @brief 0 if an empty soul gem can hold the soul, 1 if the soul may
+         * only fit in some other way.
+         */
+        int tier;
+        /**
+         * @brief The soul value left unused by the empty soul gem.
+         */
+        int unusedSoulValue;
+
+        auto operator<=>(const SoulFit_&) const = default;
+    };
+
+    [[nodiscard]] std::optional<SoulFit_> getSoulFit_(
+        const SoulGemInventory& inventory,
+        const SoulSize soulSize,
+        const bool allowPartiallyFillingSoulGems)
+    {
+        if (inventory.status() != InventoryStatus::HasSoulGemsToFill) {
+            return std::nullopt;
+        }
+
+        const auto soulValue = static_cast<int>(toSoulLevelValue(soulSize));
+
+        // The capacities are ordered from the smallest soul gem up.
+        for (const auto capacity :
+             getSoulGemCapacitiesFor(soulSize, allowPartiallyFillingSoulGems)) {
+            if (inventory.count(capacity, SoulSize::None) > 0) {
+                const auto capacityValue =
+                    static_cast<int>(toSoulLevelValue(toSoulSize(capacity)));
+
+                return SoulFit_{0, capacityValue - soulValue};
+            }
+        }
+
+        return SoulFit_{1, 0};
+    }
+
+    /**
+     * @brief Returns the actors the caster's souls may be diverted to, in
+     * order of preference.
+     */
+    [[nodiscard]] std::vector<RE::Actor*>
+        getDiversionTargets_(RE::Actor* const caster)
+    {
+        std::vector<RE::Actor*> targets;
+
+        if (const auto player = RE::PlayerCharacter::GetSingleton();
+            player != nullptr) {
+            targets.push_back(player);
+        } else {
+            LOG_WARN("Failed to find player reference for soul diversion.");
+        }
+
+        targets.push_back(caster);
+
+        if (const auto processLists = RE::ProcessLists::GetSingleton();
+            processLists != nullptr) {
+            for (const auto& handle : processLists->highActorHandles) {
+                const auto actor = handle.get().get();
+
+                if (actor != nullptr && actor != caster &&
+                    actor->IsPlayerTeammate() && !actor->IsDead(false)) {
+                    targets.push_back(actor);
+                }
+            }
+        }
+
+        return targets;
+    }
+} // namespace
+
+RE::Actor* getProxyCaster(RE::Actor* const caster, RE::Actor* const victim)
+{
+    const auto& config = YASTMConfig::getInstance();
+
+    if (caster == nullptr || victim == nullptr ||
+        !config.getGlobalBool(BoolConfigKey::AllowSoulDiversion) ||
+        !caster->IsPlayerTeammate()) {
+        return caster;
+    }
+
+    const auto soulSize = getActorSoulSize(victim);
+    const auto allowPartiallyFillingSoulGems =
+        config.getGlobalBool(BoolConfigKey::AllowPartiallyFillingSoulGems);
+    auto& soulGemIndex = SoulGemIndex::getInstance();
+
+    RE::Actor* proxyCaster = caster;
+    std::optional<SoulFit_> bestFit;
+
+    for (const auto target : getDiversionTargets_(caster)) {
+        const auto fit = getSoulFit_(
+            *soulGemIndex.get(target),
+            soulSize,
+            allowPartiallyFillingSoulGems);
+
+        if (fit.has_value() && (!bestFit.has_value() || *fit < *bestFit)) {
+            bestFit = fit;
+            proxyCaster = target;
+        }
+    }
+
+    if (proxyCaster != caster) {
+        LOG_TRACE_FMT("Soul trap diverted to {}."sv, proxyCaster->GetName());
+    }
+
+    return proxyCaster;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+namespace RE {
+    class Actor;
+} // namespace RE
+
+/**
+ * @brief Returns the actor whose soul gems the victim's soul should go to.
+ *
+ * If soul diversion is enabled and the caster is a teammate of the player, the
+ * soul goes to whichever of the player, the caster and the player's other
+ * active teammates has the best fitting soul gem for it:
+ *
+ * - Empty soul gems that can hold the soul are the best fit, the smaller the
+ *   better.
+ * - Otherwise, any soul gem that can still be filled may fit, e.g. by
+ *   displacing a soul.
+ *
+ * Ties favor the player, then the caster. If no one has a soul gem to fill,
+ * the soul stays with the caster.
+ *
+ * This only reads the indexed soul gem counts of each inventory.
+ */
+RE::Actor* getProxyCaster(RE::Actor* caster, RE::Actor* victim);
@@ -1,84 +1,186 @@
-#include "SoulTrapData.hpp"
-
-#include <cassert>
-
-#include "../global.hpp"
-
-namespace {
-    int getSoulTrapLevel_(RE::Actor* const actor)
-    {
-        using AV = RE::ActorValue;
-
-        const auto conjurationLevel = actor->GetActorValue(AV::kConjuration);
-
-        LOG_TRACE_FMT(
-            "Retrieved conjuration skill level: {}",
-            conjurationLevel);
-
-        return static_cast<int>(conjurationLevel);
-    }
-} // end namespace
-
-SoulTrapData::SoulTrapData(RE::Actor* const caster)
-    : caster_(caster)
-    , soulTrapLevel_(getSoulTrapLevel_(caster))
-    , config(YASTMConfig::getInstance(), soulTrapLevel_)
-{
-    if (config.get<EC::SoulTrapLevelingType>() == SoulTrapLevelingType::None ||
-        soulTrapLevel_ >= config[IC::SoulTrapThresholdBlack]) {
-        maxTrappableSoulSize_ = SoulSize::Black;
-    } else if (soulTrapLevel_ >= config[IC::SoulTrapThresholdGrand]) {
-        maxTrappableSoulSize_ = SoulSize::Grand;
-    } else if (soulTrapLevel_ >= config[IC::SoulTrapThresholdGreater]) {
-        maxTrappableSoulSize_ = SoulSize::Greater;
-    } else if (soulTrapLevel_ >= config[IC::SoulTrapThresholdCommon]) {
-        maxTrappableSoulSize_ = SoulSize::Common;
-    } else if (soulTrapLevel_ >= config[IC::SoulTrapThresholdLesser]) {
-        maxTrappableSoulSize_ = SoulSize::Lesser;
-    } else if (soulTrapLevel_ >= config[IC::SoulTrapThresholdPetty]) {
-        maxTrappableSoulSize_ = SoulSize::Petty;
-    } else {
-        maxTrappableSoulSize_ = SoulSize::None;
-    }
-}
-
-void SoulTrapData::resetInventoryData_()
-{
-    std::size_t maxFilledSoulGemsCount = 0;
-
-    // This should be a move.
-    inventoryMap_ =
-        getInventoryFor(caster_, [&](const RE::TESBoundObject& obj) {
-            return obj.IsSoulGem();
-        });
-
-    // Counts the number of fully-filled soul gems.
-    //
-    // Note: This ignores the fact that we can still displace white
-    // grand souls from black soul gems and vice versa.
-    //
-    // However, displacing white grand souls from black soul gems only
-    // adds value when there exists a soul gem it can be displaced to,
-    // thus it's preferable that we exit the soul processing anyway.
-    for (const auto& [obj, entryData] : inventoryMap_) {
-        const auto soulGem = obj->As<RE::TESSoulGem>();
-
-        // Can happen if the type-cast failed, but all objects in the map
-        // *should* be soul gems already.
-        assert(soulGem != nullptr);
-
-        if (soulGem->GetMaximumCapacity() == soulGem->GetContainedSoul()) {
-            ++maxFilledSoulGemsCount;
-        }
-    }
-
-    if (inventoryMap_.size() <= 0) {
-        casterInventoryStatus_ = InventoryStatus::NoSoulGemsOwned;
-    } else if (inventoryMap_.size() == maxFilledSoulGemsCount) {
-        casterInventoryStatus_ = InventoryStatus::AllSoulGemsFilled;
-    } else {
-        casterInventoryStatus_ = InventoryStatus::HasSoulGemsToFill;
-    }
-
-    isInventoryMapDirty_ = false;
-}
+#include "SoulTrapData.hpp"
+
+#include <cassert>
+
+#include "../global.hpp"
+#include "../formatters/TESSoulGem.hpp"
+#include "../utilities/rng.hpp"
+
+namespace {
+    int getSoulTrapLevel_(RE::Actor* const actor)
+    {
+        using AV = RE::ActorValue;
+
+        const auto conjurationLevel = actor->GetActorValue(AV::kConjuration);
+
+        LOG_TRACE_FMT(
+            "Retrieved conjuration skill level: {}",
+            conjurationLevel);
+
+        return static_cast<int>(conjurationLevel);
+    }
+
+    [[nodiscard]] RE::ExtraDataList*
+        getFirstExtraDataList_(RE::InventoryEntryData* const entryData)
+    {
+        const auto extraLists = entryData->extraLists;
+
+        if (extraLists == nullptr || extraLists->empty()) {
+            return nullptr;
+        }
+
+        return extraLists->front();
+    }
+} // end namespace
+
+SoulTrapDataBase::SoulTrapDataBase(RE::Actor* const caster)
+    : caster_(caster)
+    , soulTrapLevel_(getSoulTrapLevel_(caster))
+    , config(YASTMConfig::getInstance(), soulTrapLevel_)
+{
+    if (config.get<EC::SoulTrapLevelingType>() == SoulTrapLevelingType::None ||
+        soulTrapLevel_ >= config[IC::SoulTrapThresholdBlack]) {
+        maxTrappableSoulSize_ = SoulSize::Black;
+    } else if (soulTrapLevel_ >= config[IC::SoulTrapThresholdGrand]) {
+        maxTrappableSoulSize_ = SoulSize::Grand;
+    } else if (soulTrapLevel_ >= config[IC::SoulTrapThresholdGreater]) {
+        maxTrappableSoulSize_ = SoulSize::Greater;
+    } else if (soulTrapLevel_ >= config[IC::SoulTrapThresholdCommon]) {
+        maxTrappableSoulSize_ = SoulSize::Common;
+    } else if (soulTrapLevel_ >= config[IC::SoulTrapThresholdLesser]) {
+        maxTrappableSoulSize_ = SoulSize::Lesser;
+    } else if (soulTrapLevel_ >= config[IC::SoulTrapThresholdPetty]) {
+        maxTrappableSoulSize_ = SoulSize::Petty;
+    } else {
+        maxTrappableSoulSize_ = SoulSize::None;
+    }
+}
+
+void SoulTrapData::resetInventoryData_()
+{
+    std::size_t maxFilledSoulGemsCount = 0;
+
+    // This should be a move.
+    inventoryMap_ =
+        getInventoryFor(caster_, [&](const RE::TESBoundObject& obj) {
+            return obj.IsSoulGem();
+        });
+
+    // Counts the number of fully-filled soul gems.
+    //
+    // Note: This ignores the fact that we can still displace white
+    // grand souls from black soul gems and vice versa.
+    //
+    // However, displacing white grand souls from black soul gems only
+    // adds value when there exists a soul gem it can be displaced to,
+    // thus it's preferable that we exit the soul processing anyway.
+    for (const auto& [obj, entryData] : inventoryMap_) {
+        const auto soulGem = obj->As<RE::TESSoulGem>();
+
+        // Can happen if the type-cast failed, but all objects in the map
+        // *should* be soul gems already.
+        assert(soulGem != nullptr);
+
+        if (soulGem->GetMaximumCapacity() == soulGem->GetContainedSoul()) {
+            ++maxFilledSoulGemsCount;
+        }
+    }
+
+    if (inventoryMap_.size() <= 0) {
+        casterInventoryStatus_ = InventoryStatus::NoSoulGemsOwned;
+    } else if (inventoryMap_.size() == maxFilledSoulGemsCount) {
+        casterInventoryStatus_ = InventoryStatus::AllSoulGemsFilled;
+    } else {
+        casterInventoryStatus_ = InventoryStatus::HasSoulGemsToFill;
+    }
+
+    isInventoryMapDirty_ = false;
+}
+
+std::optional<SearchResult> SoulTrapData::findFirstOwnedSoulGem(
+    const SoulGemMap::IteratorPair& soulGems) const
+{
+    const auto& [begin, end] = soulGems;
+    const auto& inventoryMap = this->inventoryMap();
+
+    for (auto it = begin; it != end; ++it) {
+        const auto boundObject = it->As<RE::TESBoundObject>();
+
+        if (inventoryMap.contains(boundObject)) {
+            if (const auto& data = inventoryMap.at(boundObject);
+                data.first > 0) {
+                return std::make_optional<SearchResult>(
+                    it,
+                    data.first,
+                    data.second.get());
+            }
+        }
+    }
+
+    return std::nullopt;
+}
+
+void SoulTrapData::replaceSoulGem(
+    RE::TESSoulGem* const soulGemToAdd,
+    const SearchResult& soulGemToRemove)
+{
+    RE::ExtraDataList* oldExtraList = nullptr;
+    std::unique_ptr<RE::ExtraDataList> newExtraList;
+
+    if (config[BC::AllowExtraSoulRelocation] ||
+        config[BC::PreserveOwnership]) {
+        oldExtraList = getFirstExtraDataList_(soulGemToRemove.entryData());
+    }
+
+    if (config[BC::AllowExtraSoulRelocation] && oldExtraList != nullptr) {
+        const RE::SOUL_LEVEL soulLevel = oldExtraList->GetSoulLevel();
+
+        if (soulLevel != RE::SOUL_LEVEL::kNone) {
+            SoulSize soulSize;
+
+            // Assume that soul gems that can hold black souls and contain a
+            // grand soul are holding a black soul (original information is
+            // long gone anyway).
+            if (soulLevel == RE::SOUL_LEVEL::kGrand &&
+                canHoldBlackSoul(soulGemToRemove.soulGem())) {
+                soulSize = SoulSize::Black;
+            } else {
+                soulSize = toSoulSize(soulLevel);
+            }
+
+            // Add the extra soul into the queue.
+            LOG_TRACE_FMT("Relocating extra soul of size: {:t}", soulSize);
+            victims_.emplace(soulSize);
+        }
+    }
+
+    if (config[BC::PreserveOwnership]) {
+        newExtraList = createExtraDataListFromOriginal(oldExtraList);
+    }
+
+    LOG_TRACE_FMT("Replacing soul gems in {}'s inventory", caster_->GetName());
+    LOG_TRACE_FMT("- from: {:f}", *soulGemToRemove.soulGem());
+    LOG_TRACE_FMT("- to: {:f}", *soulGemToAdd);
+
+    caster_->AddObjectToContainer(
+        soulGemToAdd,
+        newExtraList.release(), // Transfer ownership to the engine.
+        1,
+        nullptr);
+    caster_->RemoveItem(
+        soulGemToRemove.soulGem(),
+        1,
+        RE::ITEM_REMOVE_REASON::kRemove,
+        oldExtraList,
+        nullptr);
+    setInventoryHasChanged();
+}
+
+bool SoulTrapData::rollSoulTrapSuccess(const double successChance) const
+{
+    const auto x = Rng::getInstance().generateUniform(0.0, 1.0);
+
+    LOG_TRACE_FMT("chance={}, x={}", successChance, x);
+
+    return successChance >= x;
+}
@@ -1,189 +1,289 @@
-#pragma once
-
-#include <optional>
-
-#include <RE/A/Actor.h>
-#include <RE/M/Misc.h>
-#include <RE/P/PlayerCharacter.h>
-#include <RE/S/SoulsTrapped.h>
-#include <RE/T/TESForm.h>
-#include <RE/T/TESBoundObject.h>
-
-#include "types.hpp"
-#include "InventoryStatus.hpp"
-#include "Victim.hpp"
-#include "../global.hpp"
-#include "../messages.hpp"
-#include "../config/YASTMConfig.hpp"
-#include "../utilities/misc.hpp"
-
-/**
- * @brief Stores and bookkeeps the data for various soul trap variables so
- * we don't end up with functions needing half a dozen arguments.
- */
-class SoulTrapData {
-public:
-    using InventoryItemMap = UnorderedInventoryItemMap;
-
-private:
-    static const std::size_t MAX_NOTIFICATION_COUNT = 1;
-    std::size_t notifyCount_ = 0;
-    bool isSoulTrapEventSent_ = false;
-    bool isInventoryMapDirty_ = true;
-
-    RE::Actor* caster_;
-    // [DEVNOTE] Make sure this variable appears before the config variable
-    //           since the value is passed to the snapshot's constructor.
-    /**
-     * @brief The "level" of the soul trap. This is currently based on the
-     * caster's conjuration skill level.
-     *
-     * Note: This is not necessarily the player level.
-     */
-    int soulTrapLevel_;
-    SoulSize maxTrappableSoulSize_;
-    InventoryStatus casterInventoryStatus_;
-    UnorderedInventoryItemMap inventoryMap_;
-
-    VictimsQueue victims_;
-    std::optional<Victim> victim_;
-    bool isDegradedSoulTrap_ = false;
-
-    template <typename MessageKey>
-    void notify_(MessageKey message);
-    void sendSoulTrapEvent_(RE::Actor* victim);
-    void resetInventoryData_();
-
-public:
-    const YASTMConfig::Snapshot config;
-    SoulTrapData(RE::Actor* caster);
-
-    SoulTrapData(const SoulTrapData&) = delete;
-    SoulTrapData(SoulTrapData&&) = delete;
-    SoulTrapData& operator=(const SoulTrapData&) = delete;
-    SoulTrapData& operator=(SoulTrapData&&) = delete;
-
-    void setInventoryHasChanged() noexcept { isInventoryMapDirty_ = true; }
-    void updateLoopVariables();
-
-    RE::Actor* caster() const noexcept { return caster_; }
-    int soulTrapLevel() const noexcept { return soulTrapLevel_; }
-    SoulSize maxTrappableSoulSize() const noexcept
-    {
-        return maxTrappableSoulSize_;
-    }
-    int getThresholdForSoulSize(SoulSize soulSize) const;
-    InventoryStatus casterInventoryStatus() const;
-    const InventoryItemMap& inventoryMap() const;
-
-    VictimsQueue& victims() noexcept { return victims_; }
-    const VictimsQueue& victims() const noexcept { return victims_; }
-
-    const Victim& victim() const { return victim_.value(); }
-    void setDegradedSoulTrap(bool isDegraded = true)
-    {
-        isDegradedSoulTrap_ = isDegraded;
-    }
-    bool isDegradedSoulTrap() const { return isDegradedSoulTrap_; }
-
-    void notifySoulTrapFailure(const SoulTrapFailureMessage message);
-
-    void notifySoulTrapSuccess(
-        const SoulTrapSuccessMessage message,
-        const Victim& victim);
-};
-
-template <typename MessageKey>
-inline void SoulTrapData::notify_(const MessageKey message)
-{
-    if (notifyCount_ < MAX_NOTIFICATION_COUNT &&
-        config[BC::AllowNotifications]) {
-        RE::DebugNotification(getMessage(message));
-        ++notifyCount_;
-    }
-}
-
-template <>
-inline void SoulTrapData::notify_<SoulTrapSuccessMessage>(
-    const SoulTrapSuccessMessage message)
-{
-    if (notifyCount_ < MAX_NOTIFICATION_COUNT &&
-        config[BC::AllowNotifications]) {
-        RE::DebugNotification(getMessage(message, isDegradedSoulTrap()));
-        ++notifyCount_;
-    }
-}
-
-inline void SoulTrapData::sendSoulTrapEvent_(RE::Actor* const victim)
-{
-    if (!isSoulTrapEventSent_) {
-        RE::SoulsTrapped::SendEvent(caster(), victim);
-        isSoulTrapEventSent_ = true;
-    }
-}
-
-inline void SoulTrapData::updateLoopVariables()
-{
-    victim_.emplace(victims_.top());
-    victims_.pop();
-
-    if (isInventoryMapDirty_) {
-        resetInventoryData_();
-    }
-}
-
-inline int SoulTrapData::getThresholdForSoulSize(const SoulSize soulSize) const
-{
-    using IC = IntConfigKey;
-
-    switch (soulSize) {
-    case SoulSize::Black:
-        return config[IC::SoulTrapThresholdBlack];
-    case SoulSize::Grand:
-        return config[IC::SoulTrapThresholdGrand];
-    case SoulSize::Greater:
-        return config[IC::SoulTrapThresholdGreater];
-    case SoulSize::Common:
-        return config[IC::SoulTrapThresholdCommon];
-    case SoulSize::Lesser:
-        return config[IC::SoulTrapThresholdLesser];
-    case SoulSize::Petty:
-        return config[IC::SoulTrapThresholdPetty];
-    }
-
-    return 1;
-}
-
-inline InventoryStatus SoulTrapData::casterInventoryStatus() const
-{
-    // This should not happen if the class is used correctly (the class does
-    // not manage these resources on its own for performance).
-    assert(!isInventoryMapDirty_);
-    return casterInventoryStatus_;
-}
-
-inline const SoulTrapData::InventoryItemMap& SoulTrapData::inventoryMap() const
-{
-    // This should not happen if the class is used correctly (the class does
-    // not manage these resources on its own for performance).
-    assert(!isInventoryMapDirty_);
-    return inventoryMap_;
-}
-
-inline void
-    SoulTrapData::notifySoulTrapFailure(const SoulTrapFailureMessage message)
-{
-    if (caster_->IsPlayerRef()) {
-        notify_(message);
-    }
-}
-
-inline void SoulTrapData::notifySoulTrapSuccess(
-    const SoulTrapSuccessMessage message,
-    const Victim& victim)
-{
-    if (caster_->IsPlayerRef() && victim.isPrimarySoul()) {
-        notify_(message);
-        sendSoulTrapEvent_(victim.actor());
-    }
-}
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include <RE/A/Actor.h>
+#include <RE/M/Misc.h>
+#include <RE/P/PlayerCharacter.h>
+#include <RE/T/TESForm.h>
+#include <RE/T/TESBoundObject.h>
+
+#include "types.hpp"
+#include "InventoryStatus.hpp"
+#include "NotificationThrottle.hpp"
+#include "SearchResult.hpp"
+#include "Victim.hpp"
+#include "../global.hpp"
+#include "../messages.hpp"
+#include "../config/YASTMConfig.hpp"
+#include "../utilities/misc.hpp"
+
+/**
+ * @brief Stores and bookkeeps the soul trap variables that don't depend on
+ * whether the soul trap changes the caster's inventory.
+ */
+class SoulTrapDataBase {
+protected:
+    RE::Actor* caster_;
+    // [DEVNOTE] Make sure this variable appears before the config variable
+    //           since the value is passed to the snapshot's constructor.
+    /**
+     * @brief The "level" of the soul trap. This is currently based on the
+     * caster's conjuration skill level.
+     *
+     * Note: This is not necessarily the player level.
+     */
+    int soulTrapLevel_;
+    SoulSize maxTrappableSoulSize_;
+
+    VictimsQueue victims_;
+    std::optional<Victim> victim_;
+    std::vector<Victim> unplacedVictims_;
+    bool isDegradedSoulTrap_ = false;
+
+    /**
+     * @brief Makes the largest soul in the queue the current victim.
+     */
+    void popVictim_()
+    {
+        victim_.emplace(victims_.top());
+        victims_.pop();
+    }
+
+public:
+    const YASTMConfig::Snapshot config;
+    explicit SoulTrapDataBase(RE::Actor* caster);
+
+    SoulTrapDataBase(const SoulTrapDataBase&) = delete;
+    SoulTrapDataBase(SoulTrapDataBase&&) = delete;
+    SoulTrapDataBase& operator=(const SoulTrapDataBase&) = delete;
+    SoulTrapDataBase& operator=(SoulTrapDataBase&&) = delete;
+
+    RE::Actor* caster() const noexcept { return caster_; }
+    int soulTrapLevel() const noexcept { return soulTrapLevel_; }
+    SoulSize maxTrappableSoulSize() const noexcept
+    {
+        return maxTrappableSoulSize_;
+    }
+    int getThresholdForSoulSize(SoulSize soulSize) const;
+
+    VictimsQueue& victims() noexcept { return victims_; }
+    const VictimsQueue& victims() const noexcept { return victims_; }
+
+    const Victim& victim() const { return victim_.value(); }
+    void setDegradedSoulTrap(bool isDegraded = true)
+    {
+        isDegradedSoulTrap_ = isDegraded;
+    }
+    bool isDegradedSoulTrap() const { return isDegradedSoulTrap_; }
+
+    /**
+     * @brief Records that the current victim's soul couldn't be trapped.
+     */
+    void setVictimUnplaced() { unplacedVictims_.push_back(victim()); }
+    /**
+     * @brief Records that neither the current victim's soul nor any of the
+     * queued souls could be trapped, and empties the queue.
+     */
+    void setAllVictimsUnplaced();
+    /**
+     * @brief The souls that couldn't be trapped, in the order they were given
+     * up on.
+     */
+    const std::vector<Victim>& unplacedVictims() const noexcept
+    {
+        return unplacedVictims_;
+    }
+
+    /**
+     * @brief Returns whether the player should hear about this soul trap.
+     *
+     * With soul diversion, a teammate's soul may end up with another
+     * teammate, so the souls trapped by the player's teammates are reported
+     * like the player's own.
+     */
+    bool isPlayerSoulTrap() const;
+};
+
+/**
+ * @brief Stores and bookkeeps the data for various soul trap variables so
+ * we don't end up with functions needing half a dozen arguments.
+ */
+class SoulTrapData : public SoulTrapDataBase {
+public:
+    using InventoryItemMap = UnorderedInventoryItemMap;
+
+private:
+    static const std::size_t MAX_NOTIFICATION_COUNT = 1;
+    std::size_t notifyCount_ = 0;
+    bool isSoulTrapEventSent_ = false;
+    bool isInventoryMapDirty_ = true;
+
+    InventoryStatus casterInventoryStatus_;
+    UnorderedInventoryItemMap inventoryMap_;
+
+    template <typename MessageKey>
+    void notify_(MessageKey message);
+    void sendSoulTrapEvent_(RE::Actor* victim);
+    void resetInventoryData_();
+
+public:
+    explicit SoulTrapData(RE::Actor* caster)
+        : SoulTrapDataBase(caster)
+    {}
+
+    void setInventoryHasChanged() noexcept { isInventoryMapDirty_ = true; }
+    void updateLoopVariables();
+
+    InventoryStatus casterInventoryStatus() const;
+    const InventoryItemMap& inventoryMap() const;
+
+    /**
+     * @brief Returns the first soul gem in the list that the caster owns.
+     */
+    std::optional<SearchResult>
+        findFirstOwnedSoulGem(const SoulGemMap::IteratorPair& soulGems) const;
+    /**
+     * @brief Replaces a soul gem in the caster's inventory with another.
+     */
+    void replaceSoulGem(
+        RE::TESSoulGem* soulGemToAdd,
+        const SearchResult& soulGemToRemove);
+    /**
+     * @brief Decides whether a soul trap with the given chance of success
+     * succeeds.
+     */
+    bool rollSoulTrapSuccess(double successChance) const;
+
+    void notifySoulTrapFailure(const SoulTrapFailureMessage message);
+
+    void notifySoulTrapSuccess(
+        const SoulTrapSuccessMessage message,
+        const Victim& victim);
+};
+
+inline void SoulTrapDataBase::setAllVictimsUnplaced()
+{
+    setVictimUnplaced();
+
+    while (!victims_.empty()) {
+        popVictim_();
+        setVictimUnplaced();
+    }
+}
+
+inline bool SoulTrapDataBase::isPlayerSoulTrap() const
+{
+    return caster_->IsPlayerRef() ||
+           (config[BC::AllowSoulDiversion] && caster_->IsPlayerTeammate());
+}
+
+template <typename MessageKey>
+inline void SoulTrapData::notify_(const MessageKey message)
+{
+    if (notifyCount_ < MAX_NOTIFICATION_COUNT &&
+        config[BC::AllowNotifications]) {
+        NotificationThrottle::getInstance().notifySoulTrapFailure(
+            message,
+            NotificationThrottle::Duration(
+                config[IC::NotificationThrottleWindow]));
+        ++notifyCount_;
+    }
+}
+
+template <>
+inline void SoulTrapData::notify_<SoulTrapSuccessMessage>(
+    const SoulTrapSuccessMessage message)
+{
+    if (notifyCount_ < MAX_NOTIFICATION_COUNT &&
+        config[BC::AllowNotifications]) {
+        NotificationThrottle::getInstance().notifySoulTrapSuccess(
+            message,
+            isDegradedSoulTrap(),
+            NotificationThrottle::Duration(
+                config[IC::NotificationThrottleWindow]));
+        ++notifyCount_;
+    }
+}
+
+inline void SoulTrapData::sendSoulTrapEvent_(RE::Actor* const victim)
+{
+    // The victim of a pending soul may no longer exist, and the event needs
+    // one.
+    if (!isSoulTrapEventSent_ && victim != nullptr) {
+        NotificationThrottle::getInstance().sendSoulTrapEvent(
+            caster(),
+            victim,
+            NotificationThrottle::Duration(
+                config[IC::SoulTrapEventThrottleWindow]));
+
+        isSoulTrapEventSent_ = true;
+    }
+}
+
+inline void SoulTrapData::updateLoopVariables()
+{
+    popVictim_();
+
+    if (isInventoryMapDirty_) {
+        resetInventoryData_();
+    }
+}
+
+inline int
+    SoulTrapDataBase::getThresholdForSoulSize(const SoulSize soulSize) const
+{
+    using IC = IntConfigKey;
+
+    switch (soulSize) {
+    case SoulSize::Black:
+        return config[IC::SoulTrapThresholdBlack];
+    case SoulSize::Grand:
+        return config[IC::SoulTrapThresholdGrand];
+    case SoulSize::Greater:
+        return config[IC::SoulTrapThresholdGreater];
+    case SoulSize::Common:
+        return config[IC::SoulTrapThresholdCommon];
+    case SoulSize::Lesser:
+        return config[IC::SoulTrapThresholdLesser];
+    case SoulSize::Petty:
+        return config[IC::SoulTrapThresholdPetty];
+    }
+
+    return 1;
+}
+
+inline InventoryStatus SoulTrapData::casterInventoryStatus() const
+{
+    // This should not happen if the class is used correctly (the class does
+    // not manage these resources on its own for performance).
+    assert(!isInventoryMapDirty_);
+    return casterInventoryStatus_;
+}
+
+inline const SoulTrapData::InventoryItemMap& SoulTrapData::inventoryMap() const
+{
+    // This should not happen if the class is used correctly (the class does
+    // not manage these resources on its own for performance).
+    assert(!isInventoryMapDirty_);
+    return inventoryMap_;
+}
+
+inline void
+    SoulTrapData::notifySoulTrapFailure(const SoulTrapFailureMessage message)
+{
+    if (isPlayerSoulTrap()) {
+        notify_(message);
+    }
+}
+
+inline void SoulTrapData::notifySoulTrapSuccess(
+    const SoulTrapSuccessMessage message,
+    const Victim& victim)
+{
+    if (isPlayerSoulTrap() && victim.isPrimarySoul()) {
+        notify_(message);
+        sendSoulTrapEvent_(victim.actor());
+    }
+}
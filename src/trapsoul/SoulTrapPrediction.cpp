@@ -0,0 +1,65 @@
+#include "SoulTrapPrediction.hpp"
+
+#include <RE/T/TESSoulGem.h>
+
+#include "../global.hpp"
+#include "../inventory/SoulGemIndex.hpp"
+
+std::optional<SearchResult> SoulTrapPrediction::findFirstOwnedSoulGem(
+    const SoulGemMap::IteratorPair& soulGems) const
+{
+    const auto& [begin, end] = soulGems;
+
+    for (auto it = begin; it != end; ++it) {
+        if (const auto count = inventory_.countOf(it.get()); count > 0) {
+            return std::make_optional<SearchResult>(it, count, nullptr);
+        }
+    }
+
+    return std::nullopt;
+}
+
+void SoulTrapPrediction::replaceSoulGem(
+    RE::TESSoulGem* const soulGemToAdd,
+    const SearchResult& soulGemToRemove)
+{
+    const auto& soulGemIndex = SoulGemIndex::getInstance();
+
+    if (const auto soulGemClass =
+            soulGemIndex.classify(soulGemToRemove.soulGem());
+        soulGemClass != nullptr) {
+        inventory_.add(soulGemToRemove.soulGem(), *soulGemClass, -1);
+    }
+
+    if (const auto soulGemClass = soulGemIndex.classify(soulGemToAdd);
+        soulGemClass != nullptr) {
+        inventory_.add(soulGemToAdd, *soulGemClass, 1);
+    }
+
+    result_.placements.push_back(
+        SoulTrapPlacement{soulGemToRemove.soulGem(), soulGemToAdd});
+}
+
+bool SoulTrapPrediction::rollSoulTrapSuccess(const double successChance)
+{
+    result_.successChance = successChance;
+
+    return successChance > 0.0;
+}
+
+void SoulTrapPrediction::notifySoulTrapFailure(
+    const SoulTrapFailureMessage message)
+{
+    if (*result_.message == '\0') {
+        result_.message = getMessage(message);
+    }
+}
+
+void SoulTrapPrediction::notifySoulTrapSuccess(
+    const SoulTrapSuccessMessage message,
+    const Victim& victim)
+{
+    if (victim.isPrimarySoul() && *result_.message == '\0') {
+        result_.message = getMessage(message, isDegradedSoulTrap());
+    }
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include <RE/A/Actor.h>
+
+#include "types.hpp"
+#include "InventoryStatus.hpp"
+#include "SearchResult.hpp"
+#include "SoulTrapData.hpp"
+#include "Victim.hpp"
+#include "../messages.hpp"
+#include "../config/SoulGemMap.hpp"
+#include "../inventory/SoulGemInventory.hpp"
+
+namespace RE {
+    class TESSoulGem;
+} // namespace RE
+
+/**
+ * @brief A soul gem replaced while trapping a soul.
+ */
+struct SoulTrapPlacement {
+    RE::TESSoulGem* soulGemRemoved;
+    RE::TESSoulGem* soulGemAdded;
+};
+
+/**
+ * @brief The outcome of a predicted soul trap.
+ */
+struct PredictedSoulTrap {
+    std::vector<SoulTrapPlacement> placements;
+    /**
+     * @brief The translation key of the notification the soul trap would
+     * show, or an empty string if it wouldn't show any.
+     */
+    const char* message = "";
+    bool isSuccessful = false;
+    /**
+     * @brief The chance that the soul isn't lost before it's trapped. The
+     * placements assume that it isn't.
+     */
+    double successChance = 1.0;
+};
+
+/**
+ * @brief Plays the role of SoulTrapData for a simulated soul trap.
+ *
+ * The caster's soul gems are taken from a copy of their indexed counts, so
+ * the caster's inventory is neither scanned nor changed.
+ */
+class SoulTrapPrediction : public SoulTrapDataBase {
+    SoulGemInventory inventory_;
+    PredictedSoulTrap result_;
+
+public:
+    explicit SoulTrapPrediction(
+        RE::Actor* const caster,
+        const SoulGemInventory& inventory)
+        : SoulTrapDataBase(caster)
+        , inventory_(inventory)
+    {}
+
+    void updateLoopVariables() { popVictim_(); }
+
+    InventoryStatus casterInventoryStatus() const
+    {
+        return inventory_.status();
+    }
+
+    std::optional<SearchResult>
+        findFirstOwnedSoulGem(const SoulGemMap::IteratorPair& soulGems) const;
+    /**
+     * @brief Records the replacement in the simulated soul gem counts.
+     *
+     * Souls kept in the extra data of the soul gem removed are not known, so
+     * they aren't relocated even if AllowExtraSoulRelocation is enabled.
+     */
+    void replaceSoulGem(
+        RE::TESSoulGem* soulGemToAdd,
+        const SearchResult& soulGemToRemove);
+    /**
+     * @brief Records the chance of success. Assumes the soul trap succeeds
+     * unless it can't.
+     */
+    bool rollSoulTrapSuccess(double successChance);
+
+    void notifySoulTrapFailure(SoulTrapFailureMessage message);
+
+    void notifySoulTrapSuccess(
+        SoulTrapSuccessMessage message,
+        const Victim& victim);
+
+    PredictedSoulTrap& result() noexcept { return result_; }
+};
@@ -1,32 +1,47 @@
-#pragma once
-
-#include <RE/A/Actor.h>
-#include <RE/P/PlayerCharacter.h>
-
-#include "../global.hpp"
-#include "../config/ConfigKey/BoolConfigKey.hpp"
-#include "../config/YASTMConfig.hpp"
-
-bool trapSoul(RE::Actor* caster, RE::Actor* victim);
-
-/**
- * @brief Returns the caster the soul was diverted to, if any.
- */
-inline RE::Actor* getProxyCaster(RE::Actor* caster)
-{
-    const auto& config = YASTMConfig::getInstance();
-
-    if (config.getGlobalBool(BoolConfigKey::AllowSoulDiversion) &&
-        caster->IsPlayerTeammate()) {
-        const auto playerActor = RE::PlayerCharacter::GetSingleton();
-
-        if (playerActor != nullptr) {
-            LOG_TRACE("Soul trap diverted to player."sv);
-            return playerActor;
-        } else {
-            LOG_WARN("Failed to find player reference for soul diversion.");
-        }
-    }
-
-    return caster;
-}
+#pragma once
+
+#include <RE/A/Actor.h>
+
+#include "SoulDiversion.hpp"
+#include "SoulTrapPrediction.hpp"
+#include "../global.hpp"
+#include "../config/ConfigKey/BoolConfigKey.hpp"
+#include "../config/YASTMConfig.hpp"
+
+/**
+ * @brief The outcome of trapSoul().
+ */
+enum class SoulTrapOutcome {
+    /**
+     * @brief The soul wasn't trapped and the victim keeps it.
+     */
+    Failed,
+    Trapped,
+    /**
+     * @brief The caster had no soul gems to fill, so the soul was taken from
+     * the victim and held in the caster's pending soul backlog (see
+     * PendingSoulBacklog). Only happens for the player, or their teammates
+     * with soul diversion enabled.
+     */
+    Held,
+};
+
+SoulTrapOutcome trapSoul(RE::Actor* caster, RE::Actor* victim);
+
+/**
+ * @brief Traps the caster's pending souls (see PendingSoulBacklog) in a single
+ * pass. Souls that still don't fit go back to the backlog until they expire.
+ *
+ * @returns True if any soul was trapped.
+ */
+bool trapPendingSouls(RE::Actor* caster);
+
+/**
+ * @brief Predicts what trapSoul() would do if the victim were killed now,
+ * without changing anything.
+ *
+ * The soul trap runs against a copy of the caster's indexed soul gem counts,
+ * so this doesn't scan the caster's inventory. Unlike trapSoul(), the victim
+ * doesn't need to be dead.
+ */
+PredictedSoulTrap predictTrapSoul(RE::Actor* caster, RE::Actor* victim);
@@ -1,9 +1,9 @@
-#pragma once
-
-#include <utility>
-
-template <typename Container, typename... Args>
-void clearContainer(Container& container, Args... args)
-{
-    container = Container(std::forward(args)...);
-}
+#pragma once
+
+#include <utility>
+
+template <typename Container, typename... Args>
+void clearContainer(Container& container, Args... args)
+{
+    container = Container(std::forward(args)...);
+}
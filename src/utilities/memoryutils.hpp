@@ -0,0 +1,43 @@
+#pragma once
+
+#include <string>
+
+#include <cstddef>
+
+// These functions give rough estimates of heap memory usage, for diagnostics
+// only. They don't account for allocator overhead.
+
+/**
+ * @brief Returns the heap memory used by the string's buffer, which is zero if
+ * it fits in the small string buffer.
+ */
+inline std::size_t estimateHeapMemoryUsage(const std::string& str)
+{
+    return str.capacity() > std::string().capacity() ? str.capacity() + 1 : 0;
+}
+
+/**
+ * @brief Returns the heap memory used by a vector's buffer, not counting the
+ * heap memory owned by its elements.
+ */
+template <typename Vector>
+std::size_t estimateVectorMemoryUsage(const Vector& vector)
+{
+    return vector.capacity() * sizeof(typename Vector::value_type);
+}
+
+/**
+ * @brief Returns the heap memory used by the nodes and buckets of a node-based
+ * hash map (or set), not counting the heap memory owned by its elements.
+ */
+template <typename HashMap>
+std::size_t estimateHashMapMemoryUsage(const HashMap& map)
+{
+    // Each node holds the value and the links of a doubly-linked list, and
+    // each bucket holds a pair of iterators.
+    constexpr std::size_t nodeOverhead = 2 * sizeof(void*);
+    constexpr std::size_t bucketSize = 2 * sizeof(void*);
+
+    return map.size() * (sizeof(typename HashMap::value_type) + nodeOverhead) +
+           map.bucket_count() * bucketSize;
+}
@@ -1,85 +1,462 @@
-#include "YASTMUtils.hpp"
-
-#include <functional>
-#include <sstream>
-
-#include <RE/M/Misc.h>
-#include <RE/V/VirtualMachine.h>
-
-#include "../global.hpp"
-#include "../messages.hpp"
-#include "../config/YASTMConfig.hpp"
-#include "../trapsoul/trapsoul.hpp"
-#include "../utilities/native.hpp"
-#include "../utilities/PapyrusFunctionRegistry.hpp"
-#include "../utilities/printerror.hpp"
-#include "../utilities/Timer.hpp"
-
-using namespace std::literals;
-using RE::BSScript::Internal::VirtualMachine;
-
-namespace {
-    RE::Actor* TrapSoulAndGetCaster(
-        [[maybe_unused]] VirtualMachine* const vm,
-        [[maybe_unused]] RE::VMStackID stackId,
-        RE::StaticFunctionTag*,
-        RE::Actor* caster,
-        RE::Actor* const victim)
-    {
-        // This logs the "enter" and "exit" messages upon construction and
-        // destruction, respectively.
-        //
-        // Also prints the time taken to run the function if profiling is
-        // enabled (timer will still run if profiling is disabled, just with no
-        // visible output).
-        class Profiler : public Timer {
-        public:
-            explicit Profiler()
-            {
-                LOG_TRACE("Entering YASTM trapSoulAndGetCaster function");
-            }
-
-            virtual ~Profiler()
-            {
-                const auto elapsedTime = elapsed();
-
-                if (YASTMConfig::getInstance().getGlobalBool(
-                        BoolConfigKey::AllowProfiling)) {
-                    LOG_INFO_FMT(
-                        "Time to trap soul: {:.7f} seconds",
-                        elapsedTime);
-                    RE::DebugNotification(
-                        fmt::format(
-                            fmt::runtime(
-                                getMessage(MiscMessage::TimeTakenToTrapSoul)),
-                            elapsedTime)
-                            .c_str());
-                }
-
-                LOG_TRACE("Exiting YASTM trapSoulAndGetCaster function");
-            }
-        } profiler;
-
-        caster = getProxyCaster(caster);
-        return trapSoul(caster, victim) ? caster : nullptr;
-    }
-
-    bool registerPapyrusFunctions_(VirtualMachine* const vm)
-    {
-        if (vm == nullptr) {
-            LOG_ERROR("Couldn't get VM State"sv);
-            return false;
-        }
-
-        PapyrusFunctionRegistry registry("YASTMUtils", vm);
-
-        registry.registerFunction("TrapSoulAndGetCaster", TrapSoulAndGetCaster);
-
-        return true;
-    }
-} // namespace
-
-bool registerYASTMUtils(const SKSE::PapyrusInterface* const papyrus)
-{
-    return papyrus->Register(registerPapyrusFunctions_);
-}
+#include "YASTMUtils.hpp"
+
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <cstdint>
+
+#include <RE/M/Misc.h>
+#include <RE/V/VirtualMachine.h>
+
+#include "../global.hpp"
+#include "../messages.hpp"
+#include "../config/YASTMConfig.hpp"
+#include "../consolidate/consolidate.hpp"
+#include "../enchanting/enchanting.hpp"
+#include "../inventory/SoulGemIndex.hpp"
+#include "../recharge/recharge.hpp"
+#include "../trapsoul/NotificationThrottle.hpp"
+#include "../trapsoul/trapsoul.hpp"
+#include "../utilities/native.hpp"
+#include "../utilities/PapyrusFunctionRegistry.hpp"
+#include "../utilities/printerror.hpp"
+#include "../utilities/Timer.hpp"
+
+using namespace std::literals;
+using RE::BSScript::Internal::VirtualMachine;
+
+namespace {
+    RE::Actor* TrapSoulAndGetCaster(
+        [[maybe_unused]] VirtualMachine* const vm,
+        [[maybe_unused]] RE::VMStackID stackId,
+        RE::StaticFunctionTag*,
+        RE::Actor* caster,
+        RE::Actor* const victim)
+    {
+        // This logs the "enter" and "exit" messages upon construction and
+        // destruction, respectively.
+        //
+        // Also prints the time taken to run the function if profiling is
+        // enabled (timer will still run if profiling is disabled, just with no
+        // visible output).
+        class Profiler : public Timer {
+        public:
+            explicit Profiler()
+            {
+                LOG_TRACE("Entering YASTM trapSoulAndGetCaster function");
+            }
+
+            virtual ~Profiler()
+            {
+                const auto elapsedTime = elapsed();
+
+                const auto& config = YASTMConfig::getInstance();
+
+                if (config.getGlobalBool(BoolConfigKey::AllowProfiling)) {
+                    LOG_INFO_FMT(
+                        "Time to trap soul: {:.7f} seconds",
+                        elapsedTime);
+                    NotificationThrottle::getInstance()
+                        .notifyTimeTakenToTrapSoul(
+                            elapsedTime,
+                            NotificationThrottle::Duration(config.getGlobalInt(
+                                IntConfigKey::NotificationThrottleWindow)));
+                }
+
+                LOG_TRACE("Exiting YASTM trapSoulAndGetCaster function");
+            }
+        } profiler;
+
+        caster = getProxyCaster(caster, victim);
+        return trapSoul(caster, victim) != SoulTrapOutcome::Failed ? caster
+                                                                   : nullptr;
+    }
+
+    std::vector<std::string> PredictTrapSoul(
+        VirtualMachine* const vm,
+        const RE::VMStackID stackId,
+        RE::StaticFunctionTag*,
+        RE::Actor* const caster,
+        RE::Actor* const victim)
+    {
+        if (caster == nullptr) {
+            vm->TraceStack("Caster is None", stackId);
+            return {};
+        }
+
+        if (victim == nullptr) {
+            vm->TraceStack("Victim is None", stackId);
+            return {};
+        }
+
+        const auto prediction =
+            predictTrapSoul(getProxyCaster(caster, victim), victim);
+
+        std::vector<std::string> results;
+        results.reserve(prediction.placements.size() + 1);
+        results.emplace_back(prediction.message);
+
+        for (const auto& [soulGemRemoved, soulGemAdded] :
+             prediction.placements) {
+            results.push_back(fmt::format(
+                "{} -> {}"sv,
+                soulGemRemoved->GetName(),
+                soulGemAdded->GetName()));
+        }
+
+        return results;
+    }
+
+    RE::TESSoulGem* GetRechargeSoulGem(
+        VirtualMachine* const vm,
+        const RE::VMStackID stackId,
+        RE::StaticFunctionTag*,
+        RE::Actor* const actor,
+        const std::int32_t missingCharge)
+    {
+        if (actor == nullptr) {
+            vm->TraceStack("Actor is None", stackId);
+            return nullptr;
+        }
+
+        try {
+            return findRechargeSoulGem(
+                actor,
+                static_cast<float>(missingCharge));
+        } catch (const std::exception& error) {
+            std::stringstream stream;
+
+            printErrorToStream(error, stream);
+            vm->TraceStack(
+                stream.str().c_str(),
+                stackId,
+                RE::BSScript::ErrorLogger::Severity::kInfo);
+        }
+
+        return nullptr;
+    }
+
+    RE::TESSoulGem* RechargeEquippedWeapon(
+        VirtualMachine* const vm,
+        const RE::VMStackID stackId,
+        RE::StaticFunctionTag*,
+        RE::Actor* const actor,
+        const bool isLeftHand)
+    {
+        if (actor == nullptr) {
+            vm->TraceStack("Actor is None", stackId);
+            return nullptr;
+        }
+
+        try {
+            const Timer timer;
+            const auto soulGem = rechargeEquippedWeapon(actor, isLeftHand);
+
+            if (YASTMConfig::getInstance().getGlobalBool(
+                    BoolConfigKey::AllowProfiling)) {
+                LOG_INFO_FMT(
+                    "Time to recharge equipped weapon: {:.7f} seconds"sv,
+                    timer.elapsed());
+            }
+
+            return soulGem;
+        } catch (const std::exception& error) {
+            std::stringstream stream;
+
+            printErrorToStream(error, stream);
+            vm->TraceStack(
+                stream.str().c_str(),
+                stackId,
+                RE::BSScript::ErrorLogger::Severity::kInfo);
+        }
+
+        return nullptr;
+    }
+
+    std::int32_t RechargeAllItems(
+        VirtualMachine* const vm,
+        const RE::VMStackID stackId,
+        RE::StaticFunctionTag*,
+        RE::Actor* const actor)
+    {
+        if (actor == nullptr) {
+            vm->TraceStack("Actor is None", stackId);
+            return 0;
+        }
+
+        try {
+            const Timer timer;
+            const auto result = rechargeAll(actor);
+
+            if (YASTMConfig::getInstance().getGlobalBool(
+                    BoolConfigKey::AllowProfiling)) {
+                LOG_INFO_FMT(
+                    "Time to recharge {} of {} items: {:.7f} seconds"sv,
+                    result.rechargedItemCount,
+                    result.itemsMissingChargeCount,
+                    timer.elapsed());
+            }
+
+            return result.rechargedItemCount;
+        } catch (const std::exception& error) {
+            std::stringstream stream;
+
+            printErrorToStream(error, stream);
+            vm->TraceStack(
+                stream.str().c_str(),
+                stackId,
+                RE::BSScript::ErrorLogger::Severity::kInfo);
+        }
+
+        return 0;
+    }
+
+    RE::TESSoulGem* GetEnchantingSoulGem(
+        VirtualMachine* const vm,
+        const RE::VMStackID stackId,
+        RE::StaticFunctionTag*,
+        RE::Actor* const actor,
+        RE::EnchantmentItem* const enchantment)
+    {
+        if (actor == nullptr) {
+            vm->TraceStack("Actor is None", stackId);
+            return nullptr;
+        }
+
+        if (enchantment == nullptr) {
+            vm->TraceStack("Enchantment is None", stackId);
+            return nullptr;
+        }
+
+        try {
+            return findEnchantingSoulGem(actor, enchantment);
+        } catch (const std::exception& error) {
+            std::stringstream stream;
+
+            printErrorToStream(error, stream);
+            vm->TraceStack(
+                stream.str().c_str(),
+                stackId,
+                RE::BSScript::ErrorLogger::Severity::kInfo);
+        }
+
+        return nullptr;
+    }
+
+    std::int32_t ConsolidateSouls(
+        VirtualMachine* const vm,
+        const RE::VMStackID stackId,
+        RE::StaticFunctionTag*,
+        RE::Actor* const actor)
+    {
+        if (actor == nullptr) {
+            vm->TraceStack("Actor is None", stackId);
+            return -1;
+        }
+
+        try {
+            return consolidateSouls(actor);
+        } catch (const std::exception& error) {
+            std::stringstream stream;
+
+            printErrorToStream(error, stream);
+            vm->TraceStack(
+                stream.str().c_str(),
+                stackId,
+                RE::BSScript::ErrorLogger::Severity::kInfo);
+        }
+
+        return -1;
+    }
+
+    std::vector<std::string> PlanSoulConsolidation(
+        VirtualMachine* const vm,
+        const RE::VMStackID stackId,
+        RE::StaticFunctionTag*,
+        RE::Actor* const actor)
+    {
+        if (actor == nullptr) {
+            vm->TraceStack("Actor is None", stackId);
+            return {};
+        }
+
+        try {
+            const auto conversions = planSoulConsolidation(actor);
+
+            if (!conversions.has_value()) {
+                return {};
+            }
+
+            std::vector<std::string> results;
+            results.reserve(conversions->size());
+
+            for (const auto& [soulGemToRemove, soulGemToAdd, count] :
+                 *conversions) {
+                results.push_back(fmt::format(
+                    "{} x {} -> {}"sv,
+                    count,
+                    soulGemToRemove->GetName(),
+                    soulGemToAdd->GetName()));
+            }
+
+            return results;
+        } catch (const std::exception& error) {
+            std::stringstream stream;
+
+            printErrorToStream(error, stream);
+            vm->TraceStack(
+                stream.str().c_str(),
+                stackId,
+                RE::BSScript::ErrorLogger::Severity::kInfo);
+        }
+
+        return {};
+    }
+
+    std::vector<std::int32_t> GetSoulGemCounts(
+        VirtualMachine* const vm,
+        const RE::VMStackID stackId,
+        RE::StaticFunctionTag*,
+        RE::Actor* const actor)
+    {
+        if (actor == nullptr) {
+            vm->TraceStack("Actor is None", stackId);
+            return {};
+        }
+
+        if (!YASTMConfig::getInstance().isReady()) {
+            vm->TraceStack("Configuration is not loaded", stackId);
+            return {};
+        }
+
+        try {
+            const auto inventory = SoulGemIndex::getInstance().get(actor);
+            std::vector<std::int32_t> counts;
+
+            // Indexed by capacity * number of soul sizes + containedSoulSize.
+            counts.reserve(
+                static_cast<std::size_t>(SoulGemCapacity::Size) *
+                static_cast<std::size_t>(SoulSize::Size));
+
+            for (SoulGemCapacityValue capacity = SoulGemCapacity::First;
+                 capacity <= SoulGemCapacity::Last;
+                 ++capacity) {
+                for (SoulSizeValue containedSoulSize = SoulSize::First;
+                     containedSoulSize <= SoulSize::Last;
+                     ++containedSoulSize) {
+                    counts.push_back(
+                        inventory->count(capacity, containedSoulSize));
+                }
+            }
+
+            return counts;
+        } catch (const std::exception& error) {
+            std::stringstream stream;
+
+            printErrorToStream(error, stream);
+            vm->TraceStack(
+                stream.str().c_str(),
+                stackId,
+                RE::BSScript::ErrorLogger::Severity::kInfo);
+        }
+
+        return {};
+    }
+
+    std::int32_t GetStoredSoulValue(
+        VirtualMachine* const vm,
+        const RE::VMStackID stackId,
+        RE::StaticFunctionTag*,
+        RE::Actor* const actor)
+    {
+        if (actor == nullptr) {
+            vm->TraceStack("Actor is None", stackId);
+            return 0;
+        }
+
+        if (!YASTMConfig::getInstance().isReady()) {
+            vm->TraceStack("Configuration is not loaded", stackId);
+            return 0;
+        }
+
+        try {
+            return SoulGemIndex::getInstance().get(actor)->storedSoulValue();
+        } catch (const std::exception& error) {
+            std::stringstream stream;
+
+            printErrorToStream(error, stream);
+            vm->TraceStack(
+                stream.str().c_str(),
+                stackId,
+                RE::BSScript::ErrorLogger::Severity::kInfo);
+        }
+
+        return 0;
+    }
+
+    std::int32_t GetFreeSoulValue(
+        VirtualMachine* const vm,
+        const RE::VMStackID stackId,
+        RE::StaticFunctionTag*,
+        RE::Actor* const actor)
+    {
+        if (actor == nullptr) {
+            vm->TraceStack("Actor is None", stackId);
+            return 0;
+        }
+
+        if (!YASTMConfig::getInstance().isReady()) {
+            vm->TraceStack("Configuration is not loaded", stackId);
+            return 0;
+        }
+
+        try {
+            return SoulGemIndex::getInstance().get(actor)->freeSoulValue();
+        } catch (const std::exception& error) {
+            std::stringstream stream;
+
+            printErrorToStream(error, stream);
+            vm->TraceStack(
+                stream.str().c_str(),
+                stackId,
+                RE::BSScript::ErrorLogger::Severity::kInfo);
+        }
+
+        return 0;
+    }
+
+    bool registerPapyrusFunctions_(VirtualMachine* const vm)
+    {
+        if (vm == nullptr) {
+            LOG_ERROR("Couldn't get VM State"sv);
+            return false;
+        }
+
+        PapyrusFunctionRegistry registry("YASTMUtils", vm);
+
+        registry.registerFunction("TrapSoulAndGetCaster", TrapSoulAndGetCaster);
+        registry.registerFunction("PredictTrapSoul", PredictTrapSoul);
+        registry.registerFunction("GetRechargeSoulGem", GetRechargeSoulGem);
+        registry.registerFunction(
+            "RechargeEquippedWeapon",
+            RechargeEquippedWeapon);
+        registry.registerFunction("RechargeAllItems", RechargeAllItems);
+        registry.registerFunction("GetEnchantingSoulGem", GetEnchantingSoulGem);
+        registry.registerFunction("ConsolidateSouls", ConsolidateSouls);
+        registry.registerFunction(
+            "PlanSoulConsolidation",
+            PlanSoulConsolidation);
+        registry.registerFunction("GetSoulGemCounts", GetSoulGemCounts);
+        registry.registerFunction("GetStoredSoulValue", GetStoredSoulValue);
+        registry.registerFunction("GetFreeSoulValue", GetFreeSoulValue);
+
+        return true;
+    }
+} // namespace
+
+bool registerYASTMUtils(const SKSE::PapyrusInterface* const papyrus)
+{
+    return papyrus->Register(registerPapyrusFunctions_);
+}